@@ -0,0 +1,180 @@
+// Appel du handler une fois la route trouvée : RouteHandler (stocké dans la RouteEntry,
+// un appel indirect) contre les formes précédentes du Router.
+//
+//   cmake --build build --target dispatch_bench && build/dispatch_bench
+//
+// - "virtual" : shared_ptr<IRequestHandler> dans l'entrée, handle_request() virtuel puis
+//   std::function ;
+// - "shared_ptr" : idem, mais le shared_ptr passé par valeur et un dynamic_pointer_cast
+//   pour les routes dynamiques, comme le Router d'origine.
+// Pour 10, 100 et 1000 routes, moitié statiques, moitié à paramètres, appelées dans un
+// ordre pseudo-aléatoire. Chaque route a son propre type de lambda (KINDS types en tout),
+// comme les handlers des contrôleurs : aucun site d'appel n'est monomorphe.
+
+#include "RouteHandler.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Softadastra;
+
+namespace
+{
+    using Request = http::request<http::string_body>;
+    using Response = http::response<http::string_body>;
+
+    // Reproduction des anciens IRequestHandler, SimpleRequestHandler et DynamicRequestHandler.
+    class IRequestHandler
+    {
+    public:
+        virtual ~IRequestHandler() = default;
+        virtual void handle_request(const Request &req, Response &res) = 0;
+    };
+
+    class OldSimpleHandler : public IRequestHandler
+    {
+    public:
+        explicit OldSimpleHandler(std::function<void(const Request &, Response &)> handler) : handler_(std::move(handler)) {}
+        void handle_request(const Request &req, Response &res) override { handler_(req, res); }
+
+    private:
+        std::function<void(const Request &, Response &)> handler_;
+    };
+
+    class OldDynamicHandler : public IRequestHandler
+    {
+    public:
+        explicit OldDynamicHandler(std::function<void(const Request &, const RouteParams &, Response &)> handler)
+            : handler_(std::move(handler)) {}
+        void handle_request(const Request &req, Response &res) override { handle_request(req, RouteParams(), res); }
+        virtual void handle_request(const Request &req, const RouteParams &params, Response &res) { handler_(req, params, res); }
+
+    private:
+        std::function<void(const Request &, const RouteParams &, Response &)> handler_;
+    };
+
+    struct OldEntry
+    {
+        std::shared_ptr<IRequestHandler> handler;
+        OldDynamicHandler *dynamic = nullptr;
+    };
+
+    struct NewEntry
+    {
+        RouteHandler handler;
+    };
+
+    constexpr std::size_t KINDS = 16;
+
+    // Ajoute la route index avec un handler de type propre à Kind ; même travail dans les
+    // deux formes : un statut et un compteur.
+    template <std::size_t Kind>
+    void add_route(std::size_t index, std::uint64_t &sink, std::vector<OldEntry> &old_entries,
+                   std::vector<NewEntry> &new_entries)
+    {
+        const unsigned status = 200 + static_cast<unsigned>(Kind % 8);
+        if (index % 2 == 0)
+        {
+            auto handler = [status, &sink](const Request &, Response &out)
+            { out.result(status); sink += Kind; };
+            old_entries.push_back(OldEntry{std::make_shared<OldSimpleHandler>(handler), nullptr});
+            new_entries.push_back(NewEntry{[handler](const Request &r, const RouteParams &, Response &out)
+                                           { handler(r, out); }});
+        }
+        else
+        {
+            auto handler = [status, &sink](const Request &, const RouteParams &p, Response &out)
+            { out.result(status); sink += p.size() + Kind; };
+            auto dynamic = std::make_shared<OldDynamicHandler>(handler);
+            old_entries.push_back(OldEntry{dynamic, dynamic.get()});
+            new_entries.push_back(NewEntry{handler});
+        }
+    }
+
+    using AddRoute = void (*)(std::size_t, std::uint64_t &, std::vector<OldEntry> &, std::vector<NewEntry> &);
+
+    template <std::size_t... Kind>
+    constexpr std::array<AddRoute, sizeof...(Kind)> route_factories(std::index_sequence<Kind...>)
+    {
+        return {&add_route<Kind>...};
+    }
+
+    void old_dispatch(std::shared_ptr<IRequestHandler> handler, const Request &req, const RouteParams &params, Response &res)
+    {
+        if (auto dynamic = std::dynamic_pointer_cast<OldDynamicHandler>(handler))
+        {
+            dynamic->handle_request(req, params, res);
+            return;
+        }
+        handler->handle_request(req, res);
+    }
+
+    template <typename F>
+    double ns_per_call(const std::vector<std::size_t> &order, F &&call)
+    {
+        const std::size_t iterations = 2000000 / order.size() + 1;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t n = 0; n < iterations; ++n)
+        {
+            for (std::size_t index : order)
+            {
+                call(index);
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations * order.size());
+    }
+}
+
+int main()
+{
+    Request req{http::verb::get, "/api/v1/resource/42", 11};
+    Response res;
+    const RouteParams params;
+    std::uint64_t sink = 0;
+    constexpr auto factories = route_factories(std::make_index_sequence<KINDS>{});
+
+    std::printf("%8s %14s %14s %14s\n", "routes", "inline (ns)", "virtual (ns)", "shared_ptr (ns)");
+    for (std::size_t routes : {10, 100, 1000})
+    {
+        std::vector<OldEntry> old_entries;
+        std::vector<NewEntry> new_entries;
+        for (std::size_t i = 0; i < routes; ++i)
+        {
+            factories[i % KINDS](i, sink, old_entries, new_entries);
+        }
+
+        std::vector<std::size_t> order(4096);
+        std::mt19937 random(42);
+        for (std::size_t &index : order)
+        {
+            index = random() % routes;
+        }
+
+        ns_per_call(order, [&](std::size_t index)
+                    { new_entries[index].handler(req, params, res); }); // mise en température
+        const double inline_ns = ns_per_call(order, [&](std::size_t index)
+                                             { new_entries[index].handler(req, params, res); });
+        const double virtual_ns = ns_per_call(order, [&](std::size_t index)
+                                              {
+                                                  const OldEntry &entry = old_entries[index];
+                                                  if (entry.dynamic)
+                                                  {
+                                                      entry.dynamic->handle_request(req, params, res);
+                                                  }
+                                                  else
+                                                  {
+                                                      entry.handler->handle_request(req, res);
+                                                  } });
+        const double shared_ns = ns_per_call(order, [&](std::size_t index)
+                                             { old_dispatch(old_entries[index].handler, req, params, res); });
+
+        std::printf("%8zu %14.2f %14.2f %14.2f\n", routes, inline_ns, virtual_ns, shared_ns);
+    }
+    return sink == 0 ? 1 : 0;
+}
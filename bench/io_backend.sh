@@ -0,0 +1,57 @@
+#!/bin/sh
+# Comparaison des backends epoll / io_uring : appels système par requête et latence p99.
+#
+#   bench/io_backend.sh [url] [durée en s] [connexions] [script wrk]
+#
+# Lancer le serveur avec "io_model": "sharded" et "io_backend": "epoll", exécuter ce
+# script, puis relancer le serveur avec "io_backend": "io_uring" et recommencer.
+# Les appels système du processus sont comptés par perf (tracepoint raw_syscalls) pendant
+# toute la durée de wrk ; le backend effectif est lu sur /server-status.
+#
+# Exemples :
+#   bench/io_backend.sh http://127.0.0.1:8080/ 30 256
+#   bench/io_backend.sh http://127.0.0.1:8080/ 30 256 bench/pipeline.lua
+
+URL=${1:-http://127.0.0.1:8080/}
+DURATION=${2:-30}
+CONNECTIONS=${3:-256}
+SCRIPT=${4:-}
+
+PID=$(pgrep -x prog | head -n 1)
+if [ -z "$PID" ]; then
+    echo "serveur (prog) introuvable" >&2
+    exit 1
+fi
+
+for tool in wrk perf curl; do
+    if ! command -v "$tool" >/dev/null 2>&1; then
+        echo "$tool requis" >&2
+        exit 1
+    fi
+done
+
+BACKEND=$(curl -s "${URL%/}/server-status" | sed -n 's/.*"backend":"\([a-z_]*\)".*/\1/p')
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+perf stat -x, -e raw_syscalls:sys_enter -p "$PID" -o "$TMP/perf.csv" -- sleep "$((DURATION + 1))" &
+PERF=$!
+sleep 1
+
+if [ -n "$SCRIPT" ]; then
+    wrk -t4 -c"$CONNECTIONS" -d"${DURATION}s" --latency -s "$SCRIPT" "$URL" > "$TMP/wrk.txt"
+else
+    wrk -t4 -c"$CONNECTIONS" -d"${DURATION}s" --latency "$URL" > "$TMP/wrk.txt"
+fi
+wait "$PERF"
+
+REQUESTS=$(sed -n 's/^ *\([0-9]*\) requests in.*/\1/p' "$TMP/wrk.txt")
+P99=$(awk '$1 == "99%" { print $2 }' "$TMP/wrk.txt")
+SYSCALLS=$(grep raw_syscalls "$TMP/perf.csv" | cut -d, -f1)
+
+cat "$TMP/wrk.txt"
+echo "backend            : ${BACKEND:-inconnu}"
+echo "requêtes           : $REQUESTS"
+echo "appels système     : $SYSCALLS"
+echo "appels / requête   : $(awk -v s="$SYSCALLS" -v r="$REQUESTS" 'BEGIN { if (r > 0) printf "%.2f", s / r; else print "n/a" }')"
+echo "latence p99        : $P99"
@@ -0,0 +1,20 @@
+-- Requêtes GET / pipelinées : chaque appel à request() envoie `depth` requêtes
+-- dans le même segment TCP, et le serveur doit répondre dans l'ordre.
+--
+--   wrk -t4 -c64 -d30s --latency -s bench/pipeline.lua http://127.0.0.1:8080/ -- 16
+--
+-- À comparer avec la même commande sans -s (une requête en vol par connexion).
+
+init = function(args)
+   local depth = tonumber(args[1]) or 16
+   local path = args[2] or "/"
+   local r = {}
+   for i = 1, depth do
+      r[i] = wrk.format("GET", path)
+   end
+   req = table.concat(r)
+end
+
+request = function()
+   return req
+end
@@ -0,0 +1,157 @@
+// Résolution des routes : arbre radix (RouteTree) contre l'ancien Router (recherche
+// exacte puis parcours linéaire, une regex construite par motif et par requête).
+//
+//   cmake --build build --target router_bench && build/router_bench
+//
+// Pour 10, 100 et 1000 routes : un tiers statiques, un tiers à un paramètre, un tiers à
+// deux paramètres. Les chemins demandés couvrent toutes les routes, plus des 404 et 405.
+
+#include "RouteTree.hpp"
+#include <chrono>
+#include <cstdio>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace Softadastra;
+
+namespace
+{
+    struct Workload
+    {
+        std::vector<std::string> patterns;
+        std::vector<std::string> paths;
+    };
+
+    Workload make_workload(std::size_t routes)
+    {
+        Workload workload;
+        for (std::size_t i = 0; i < routes; ++i)
+        {
+            const std::string base = "/api/v1/resource" + std::to_string(i);
+            switch (i % 3)
+            {
+            case 0:
+                workload.patterns.push_back(base);
+                workload.paths.push_back(base);
+                break;
+            case 1:
+                workload.patterns.push_back(base + "/{id:int}");
+                workload.paths.push_back(base + "/42");
+                break;
+            default:
+                workload.patterns.push_back(base + "/{id:int}/items/{slug:slug}");
+                workload.paths.push_back(base + "/7/items/blue-shirt");
+                break;
+            }
+        }
+        workload.paths.push_back("/api/v1/missing");
+        workload.paths.push_back("/api/v1/resource1/not-a-number");
+        return workload;
+    }
+
+    // Reproduction de l'ancien Router::matches_dynamic_route().
+    std::string to_regex(const std::string &pattern)
+    {
+        std::string regex = "^";
+        bool inside = false;
+        for (char c : pattern)
+        {
+            if (c == '{')
+            {
+                inside = true;
+                regex += "(";
+            }
+            else if (c == '}')
+            {
+                inside = false;
+                regex += "[^/]+)";
+            }
+            else if (!inside)
+            {
+                regex += c == '/' ? std::string("\\/") : std::string(1, c);
+            }
+        }
+        return regex + "$";
+    }
+
+    struct PairHash
+    {
+        std::size_t operator()(const std::pair<int, std::string> &p) const
+        {
+            return std::hash<std::string>{}(p.second) ^ static_cast<std::size_t>(p.first);
+        }
+    };
+
+    std::size_t linear_lookup(const std::unordered_map<std::pair<int, std::string>, std::size_t, PairHash> &routes,
+                              const std::string &path)
+    {
+        auto it = routes.find({0, path});
+        if (it != routes.end())
+        {
+            return it->second;
+        }
+        for (const auto &[key, index] : routes)
+        {
+            std::regex regex(to_regex(key.second));
+            std::smatch match;
+            if (std::regex_match(path, match, regex))
+            {
+                return index;
+            }
+        }
+        return RouteTree::NONE;
+    }
+
+    template <typename F>
+    double ns_per_lookup(const Workload &workload, std::size_t iterations, F &&lookup)
+    {
+        std::size_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t n = 0; n < iterations; ++n)
+        {
+            for (const auto &path : workload.paths)
+            {
+                sink += lookup(path);
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        if (sink == 1)
+        {
+            std::puts("");
+        }
+        return std::chrono::duration<double, std::nano>(elapsed).count() /
+               static_cast<double>(iterations * workload.paths.size());
+    }
+}
+
+int main()
+{
+    std::printf("%8s %16s %16s %10s\n", "routes", "radix (ns)", "linear (ns)", "speedup");
+    for (std::size_t routes : {10, 100, 1000})
+    {
+        const Workload workload = make_workload(routes);
+
+        RouteTree tree;
+        std::unordered_map<std::pair<int, std::string>, std::size_t, PairHash> linear;
+        for (std::size_t i = 0; i < workload.patterns.size(); ++i)
+        {
+            tree.insert(RoutePattern(workload.patterns[i]), http::verb::get, static_cast<std::uint32_t>(i));
+            linear[{0, workload.patterns[i]}] = i;
+        }
+
+        const double radix = ns_per_lookup(workload, 200000 / routes + 1, [&](const std::string &path)
+                                           {
+                                               RouteTree::Match match;
+                                               tree.find(path, http::verb::get, match);
+                                               return static_cast<std::size_t>(match.route); });
+        // Une regex par route et par requête : quelques passes suffisent.
+        const double old = ns_per_lookup(workload, 2000 / routes + 1, [&](const std::string &path)
+                                         { return linear_lookup(linear, path); });
+
+        std::printf("%8zu %16.0f %16.0f %9.0fx\n", routes, radix, old, old / radix);
+    }
+    return 0;
+}
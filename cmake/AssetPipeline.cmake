@@ -0,0 +1,131 @@
+# Pipeline des fichiers statiques, exécuté en mode script :
+#
+#   cmake -DASSET_SOURCE_DIR=frontend -DASSET_OUTPUT_DIR=build/assets -P cmake/AssetPipeline.cmake
+#
+# - les ressources (css, js, images...) sont renommées avec une empreinte de leur contenu
+#   (styles.css -> styles.3f2a9c1b7d4e.css) et peuvent être mises en cache "immutable" ;
+# - les pages HTML gardent leur nom (points d'entrée) mais leurs références "styles.css"
+#   ou 'styles.css' sont réécrites vers les noms avec empreinte ;
+# - chaque fichier compressible reçoit des variantes .gz (gzip -9) et .br (brotli -q 11,
+#   si l'outil est installé), conservées seulement si elles sont plus petites ;
+# - manifest.json décrit le tout pour StaticFiles.
+
+cmake_minimum_required(VERSION 3.14)
+
+if(NOT ASSET_SOURCE_DIR OR NOT ASSET_OUTPUT_DIR)
+    message(FATAL_ERROR "ASSET_SOURCE_DIR et ASSET_OUTPUT_DIR sont requis")
+endif()
+get_filename_component(ASSET_SOURCE_DIR "${ASSET_SOURCE_DIR}" ABSOLUTE)
+get_filename_component(ASSET_OUTPUT_DIR "${ASSET_OUTPUT_DIR}" ABSOLUTE)
+
+set(HASH_LENGTH 12)
+set(MIN_COMPRESS_SIZE 256)
+set(COMPRESSIBLE_EXTENSIONS .html .htm .css .js .mjs .json .map .svg .txt .xml .wasm)
+
+find_program(GZIP_EXECUTABLE gzip)
+find_program(BROTLI_EXECUTABLE brotli)
+if(NOT GZIP_EXECUTABLE)
+    message(WARNING "gzip introuvable : pas de variantes .gz")
+endif()
+if(NOT BROTLI_EXECUTABLE)
+    message(STATUS "brotli introuvable : pas de variantes .br")
+endif()
+
+file(REMOVE_RECURSE "${ASSET_OUTPUT_DIR}")
+file(MAKE_DIRECTORY "${ASSET_OUTPUT_DIR}")
+file(GLOB_RECURSE ASSETS RELATIVE "${ASSET_SOURCE_DIR}" "${ASSET_SOURCE_DIR}/*")
+list(SORT ASSETS)
+
+# Variantes compressées d'un fichier de sortie ; result reçoit le fragment JSON.
+function(compress_asset output extension result)
+    set(encodings "")
+    list(FIND COMPRESSIBLE_EXTENSIONS "${extension}" compressible)
+    file(SIZE "${ASSET_OUTPUT_DIR}/${output}" size)
+    if(compressible EQUAL -1 OR size LESS MIN_COMPRESS_SIZE)
+        set(${result} "" PARENT_SCOPE)
+        return()
+    endif()
+
+    if(BROTLI_EXECUTABLE)
+        execute_process(COMMAND "${BROTLI_EXECUTABLE}" -q 11 -c "${ASSET_OUTPUT_DIR}/${output}"
+                        OUTPUT_FILE "${ASSET_OUTPUT_DIR}/${output}.br" RESULT_VARIABLE status)
+        file(SIZE "${ASSET_OUTPUT_DIR}/${output}.br" compressed)
+        if(status EQUAL 0 AND compressed LESS size)
+            list(APPEND encodings "\"br\": \"${output}.br\"")
+        else()
+            file(REMOVE "${ASSET_OUTPUT_DIR}/${output}.br")
+        endif()
+    endif()
+
+    if(GZIP_EXECUTABLE)
+        # -n : ni nom ni date dans l'en-tête, la sortie ne dépend que du contenu.
+        execute_process(COMMAND "${GZIP_EXECUTABLE}" -9 -n -c "${ASSET_OUTPUT_DIR}/${output}"
+                        OUTPUT_FILE "${ASSET_OUTPUT_DIR}/${output}.gz" RESULT_VARIABLE status)
+        file(SIZE "${ASSET_OUTPUT_DIR}/${output}.gz" compressed)
+        if(status EQUAL 0 AND compressed LESS size)
+            list(APPEND encodings "\"gzip\": \"${output}.gz\"")
+        else()
+            file(REMOVE "${ASSET_OUTPUT_DIR}/${output}.gz")
+        endif()
+    endif()
+
+    list(JOIN encodings ", " encodings)
+    set(${result} "${encodings}" PARENT_SCOPE)
+endfunction()
+
+# 1. Ressources : copie sous leur nom avec empreinte.
+set(PAGES "")
+set(ENTRIES "")
+set(RENAMES "")
+foreach(asset IN LISTS ASSETS)
+    get_filename_component(extension "${asset}" LAST_EXT)
+    string(TOLOWER "${extension}" extension)
+    if(extension STREQUAL ".html" OR extension STREQUAL ".htm")
+        list(APPEND PAGES "${asset}")
+        continue()
+    endif()
+
+    file(SHA256 "${ASSET_SOURCE_DIR}/${asset}" digest)
+    string(SUBSTRING "${digest}" 0 ${HASH_LENGTH} digest)
+    get_filename_component(directory "${asset}" DIRECTORY)
+    get_filename_component(stem "${asset}" NAME_WLE)
+    if(directory)
+        set(hashed "${directory}/${stem}.${digest}${extension}")
+    else()
+        set(hashed "${stem}.${digest}${extension}")
+    endif()
+
+    get_filename_component(output_directory "${ASSET_OUTPUT_DIR}/${hashed}" DIRECTORY)
+    file(MAKE_DIRECTORY "${output_directory}")
+    configure_file("${ASSET_SOURCE_DIR}/${asset}" "${ASSET_OUTPUT_DIR}/${hashed}" COPYONLY)
+    compress_asset("${hashed}" "${extension}" encodings)
+
+    # Le nom avec empreinte ne change jamais de contenu ; le nom d'origine reste servi
+    # (anciens liens) mais doit être revalidé.
+    list(APPEND ENTRIES "    \"${hashed}\": {\"file\": \"${hashed}\", \"immutable\": true, \"encodings\": {${encodings}}}")
+    list(APPEND ENTRIES "    \"${asset}\": {\"file\": \"${hashed}\", \"immutable\": false, \"encodings\": {${encodings}}}")
+    list(APPEND RENAMES "${asset}|${hashed}")
+endforeach()
+
+# 2. Pages : références réécrites vers les noms avec empreinte.
+foreach(page IN LISTS PAGES)
+    file(READ "${ASSET_SOURCE_DIR}/${page}" content)
+    foreach(rename IN LISTS RENAMES)
+        string(REPLACE "|" ";" rename "${rename}")
+        list(GET rename 0 original)
+        list(GET rename 1 hashed)
+        string(REPLACE "\"${original}\"" "\"${hashed}\"" content "${content}")
+        string(REPLACE "'${original}'" "'${hashed}'" content "${content}")
+    endforeach()
+    file(WRITE "${ASSET_OUTPUT_DIR}/${page}" "${content}")
+
+    get_filename_component(extension "${page}" LAST_EXT)
+    string(TOLOWER "${extension}" extension)
+    compress_asset("${page}" "${extension}" encodings)
+    list(APPEND ENTRIES "    \"${page}\": {\"file\": \"${page}\", \"immutable\": false, \"encodings\": {${encodings}}}")
+endforeach()
+
+list(JOIN ENTRIES ",\n" ENTRIES)
+file(WRITE "${ASSET_OUTPUT_DIR}/manifest.json" "{\n  \"version\": 1,\n  \"files\": {\n${ENTRIES}\n  }\n}\n")
+list(LENGTH ASSETS count)
+message(STATUS "Assets : ${count} fichiers traités dans ${ASSET_OUTPUT_DIR}")
@@ -4,7 +4,6 @@
 #include "routing/Router.hpp"
 #include "config/Config.hpp"
 #include "http/Response.hpp"
-#include "routing/IRequestHandler.hpp"
 #include "routing/UnifiedRequestHandler.hpp"
 
 namespace Softadastra
@@ -19,12 +18,27 @@ namespace Softadastra
     protected:
         Config &config_;
         template <typename Handler>
-        void add_route(Router &router, http::verb method, const std::string &path, Handler handler)
+        void add_route(Router &router, http::verb method, const std::string &path, Handler handler,
+                       ExecutionPolicy policy = ExecutionPolicy::Inline)
         {
-            router.add_route(
-                method, path,
-                std::static_pointer_cast<IRequestHandler>(
-                    std::make_shared<UnifiedRequestHandler>(handler)));
+            router.add_route(method, path, UnifiedRequestHandler(std::move(handler)), policy);
+        }
+
+        // Route à paramètres typés : Pattern est un RoutePattern constexpr, vérifié à la compilation.
+        template <const RoutePattern &Pattern, typename Handler>
+        void add_typed_route(Router &router, http::verb method, Handler handler,
+                             ExecutionPolicy policy = ExecutionPolicy::Inline)
+        {
+            router.add_typed_route<Pattern>(method, std::move(handler), policy);
+        }
+
+        // Réponse constante : build(res) n'est appelé qu'une fois, au démarrage.
+        template <typename Builder>
+        void add_prebuilt_route(Router &router, http::verb method, const std::string &path, Builder build)
+        {
+            http::response<http::string_body> response;
+            build(response);
+            router.add_prebuilt_route(method, path, std::move(response));
         }
     };
 
@@ -21,15 +21,11 @@ namespace Softadastra
 
         void configure(Router &routes) override
         {
-            routes.add_route(
-                http::verb::get, "/",
-                std::static_pointer_cast<IRequestHandler>(
-                    std::make_shared<UnifiedRequestHandler>(
-                        [this](const http::request<http::string_body> &req [[maybe_unused]],
-                               http::response<http::string_body> &res [[maybe_unused]])
-                        {
-                            Response::success_response(res, "Hello world");
-                        })));
+            add_prebuilt_route(routes, http::verb::get, "/",
+                               [](http::response<http::string_body> &res)
+                               {
+                                   Response::success_response(res, "Hello world");
+                               });
         }
     };
 } // namespace Softadastra
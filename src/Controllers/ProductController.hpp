@@ -16,61 +16,49 @@ namespace Softadastra
     public:
         using Controller::Controller;
 
+        static constexpr RoutePattern by_id{"/products/{id:int}"};
+        static constexpr RoutePattern by_slug{"/products/{slug:slug}"};
+        static constexpr RoutePattern by_id_and_slug{"/products/{id:int}/{slug:slug}"};
+
         void configure(Router &router) override
         {
-
-            router.add_route(http::verb::get, "/products/{id}",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [](const std::unordered_map<std::string, std::string> &params,
-                                        http::response<http::string_body> &res)
+            // "/products/search?q=..." : le texte statique passe avant {slug:slug}.
+            router.add_route(http::verb::get, "/products/search",
+                             DynamicRequestHandler(
+                                 [](const RouteParams &params, http::response<http::string_body> &res)
+                                 {
+                                     char buffer[256];
+                                     boost::beast::string_view query;
+                                     if (!params.query().get("q", buffer, query) || query.empty())
                                      {
-                                         try
-                                         {
-                                             std::string product_id = params.at("id");
-                                             Softadastra::Response::success_response(res, "Product details for id: " + product_id);
-                                         }
-                                         catch (const std::out_of_range &e)
-                                         {
-                                             throw std::invalid_argument("Missing required parameter: 'id'");
-                                         }
-                                     })));
+                                         Softadastra::Response::error_response(res, http::status::bad_request, "Missing 'q' parameter.");
+                                         return;
+                                     }
+                                     Softadastra::Response::success_response(res, "Search results for: " + std::string(query));
+                                 }));
 
-            router.add_route(http::verb::get, "/products/{slug}",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [](const std::unordered_map<std::string, std::string> &params,
-                                        http::response<http::string_body> &res)
-                                     {
-                                         try
-                                         {
-                                             std::string slug = params.at("slug");
-                                             Softadastra::Response::success_response(res, "Product details for slug: " + slug);
-                                         }
-                                         catch (const std::out_of_range &e)
-                                         {
-                                             throw std::invalid_argument("Missing required parameter: 'slug'");
-                                         }
-                                     })));
+            // "/products/42" : {id:int} est essayé avant {slug:slug}.
+            add_typed_route<by_id>(router, http::verb::get,
+                                   [](const http::request<http::string_body> &, std::int64_t id,
+                                      http::response<http::string_body> &res)
+                                   {
+                                       Softadastra::Response::success_response(res, "Product details for id: " + std::to_string(id));
+                                   });
 
-            router.add_route(http::verb::get, "/products/{id}/{slug}",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [this](const std::unordered_map<std::string, std::string> &params,
-                                            http::response<http::string_body> &res)
+            add_typed_route<by_slug>(router, http::verb::get,
+                                     [](const http::request<http::string_body> &, boost::beast::string_view slug,
+                                        http::response<http::string_body> &res)
                                      {
-                                         try
-                                         {
-                                             std::string id = params.at("id");
-                                             std::string slug = params.at("slug");
+                                         Softadastra::Response::success_response(res, "Product details for slug: " + std::string(slug));
+                                     });
 
-                                             Softadastra::Response::success_response(res, "Product details for id: " + id + " and slug: " + slug);
-                                         }
-                                         catch (const std::out_of_range &e)
-                                         {
-                                             throw std::invalid_argument("Missing required parameters: 'id' and/or 'slug'");
-                                         }
-                                     })));
+            add_typed_route<by_id_and_slug>(router, http::verb::get,
+                                            [](const http::request<http::string_body> &, std::int64_t id,
+                                               boost::beast::string_view slug, http::response<http::string_body> &res)
+                                            {
+                                                Softadastra::Response::success_response(res, "Product details for id: " + std::to_string(id) +
+                                                                                                 " and slug: " + std::string(slug));
+                                            });
         }
     };
 
@@ -11,73 +11,56 @@ namespace Softadastra
     public:
         using Controller::Controller;
 
+        static constexpr RoutePattern update_user{"/update_user/{id:int}"};
+
         void configure(Router &router) override
         {
-            add_route(router, http::verb::get, "/",
-                      [this](const http::request<http::string_body> &,
-                             http::response<http::string_body> &res)
-                      {
-                          Response::success_response(res, "Hello from test");
-                      });
-
-            add_route(router, http::verb::get, "test",
-                      [](const http::request<http::string_body> &req, http::response<http::string_body> &res)
-                      {
-                          Response::success_response(res, "heelo form test");
-                      });
-
-            add_route(router, http::verb::put, "/update_user/{id}",
-                      [this](const http::request<http::string_body> &req, http::response<http::string_body> &res)
-                      {
-                          std::unordered_map<std::string, std::string> params = UnifiedRequestHandler::extract_dynamic_params_public(std::string(req.target()));
-                          if (params.find("id") == params.end())
-                          {
-                              Response::error_response(res, http::status::bad_request, "Missing 'id' parameter.");
-                              return;
-                          }
+            add_prebuilt_route(router, http::verb::get, "/test",
+                               [](http::response<http::string_body> &res)
+                               {
+                                   Response::success_response(res, "Hello from test");
+                               });
 
-                          std::string id_str = params["id"];
-                          int id;
-                          try
-                          {
-                              id = std::stoi(id_str);
-                          }
-                          catch (const std::exception &)
-                          {
-                              Response::error_response(res, http::status::bad_request, "Invalid 'id' parameter. Must be an integer.");
-                              return;
-                          }
+            add_prebuilt_route(router, http::verb::get, "/test/hello",
+                               [](http::response<http::string_body> &res)
+                               {
+                                   Response::success_response(res, "heelo form test");
+                               });
 
-                          if (req.body().empty())
-                          {
-                              Response::error_response(res, http::status::bad_request, "Empty request body.");
-                              return;
-                          }
+            add_typed_route<update_user>(router, http::verb::put,
+                                         [](const http::request<http::string_body> &req, std::int64_t id,
+                                            http::response<http::string_body> &res)
+                                         {
+                                             if (req.body().empty())
+                                             {
+                                                 Response::error_response(res, http::status::bad_request, "Empty request body.");
+                                                 return;
+                                             }
 
-                          json request_json;
-                          try
-                          {
-                              request_json = json::parse(req.body());
-                          }
-                          catch (const std::exception &)
-                          {
-                              Response::error_response(res, http::status::bad_request, "Invalid JSON body.");
-                              return;
-                          }
+                                             json request_json;
+                                             try
+                                             {
+                                                 request_json = json::parse(req.body());
+                                             }
+                                             catch (const std::exception &)
+                                             {
+                                                 Response::error_response(res, http::status::bad_request, "Invalid JSON body.");
+                                                 return;
+                                             }
 
-                          if (request_json.find("username") == request_json.end())
-                          {
-                              Response::error_response(res, http::status::bad_request, "Le champ 'username' est manquant.");
-                              return;
-                          }
+                                             if (request_json.find("username") == request_json.end())
+                                             {
+                                                 Response::error_response(res, http::status::bad_request, "Le champ 'username' est manquant.");
+                                                 return;
+                                             }
 
-                          std::string username = request_json["username"];
-                          spdlog::info("Updating user {} with username: {}", id, username);
+                                             std::string username = request_json["username"];
+                                             spdlog::info("Updating user {} with username: {}", id, username);
 
-                          Response::success_response(res, "Request received successfully with data.");
-                      });
+                                             Response::success_response(res, "Request received successfully with data.");
+                                         });
         }
     };
 } // namespace Softadastra
 
-#endif
\ No newline at end of file
+#endif
@@ -29,6 +29,18 @@ public:
         email_ = userEmail;
     }
 
+    // Version de la ligne pour l'ETag : la table n'a pas de colonne updated_at, ses
+    // champs en tiennent lieu (bien moins cher que to_json().dump()).
+    std::string version() const
+    {
+        std::string version = std::to_string(id_);
+        version.push_back('\0');
+        version += full_name_;
+        version.push_back('\0');
+        version += email_;
+        return version;
+    }
+
     json to_json() const
     {
         return nlohmann::json{
@@ -20,154 +20,157 @@ namespace Softadastra
     public:
         using Controller::Controller;
 
+        static constexpr RoutePattern by_id{"/users/{id:int}"};
+        static constexpr RoutePattern update_by_id{"/update/{id:int}"};
+
         void configure(Router &router) override
         {
             auto self = std::shared_ptr<UserController>(this, [](UserController *) {});
 
+            // Chaque route fait un appel MySQL synchrone : elles passent par le pool bloquant
+            // pour ne jamais immobiliser un thread io.
+
             router.add_route(http::verb::get, "/users",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [self](const std::unordered_map<std::string, std::string> &,
-                                            http::response<http::string_body> &res)
+                             DynamicRequestHandler(
+                                 [self](const RouteParams &,
+                                        http::response<http::string_body> &res)
+                                 {
+                                     try
                                      {
-                                         try
-                                         {
-                                             std::vector<User> users = self->findAll();
+                                         std::vector<User> users = self->findAll();
 
-                                             if (!users.empty())
-                                             {
-                                                 nlohmann::json users_json = nlohmann::json::array();
-                                                 for (const auto &user : users)
-                                                 {
-                                                     users_json.push_back(user.to_json());
-                                                 }
-                                                 Response::json_response(res, users_json);
-                                             }
-                                             else
-                                             {
-                                                 Softadastra::Response::no_content_response(res, "No users found");
-                                             }
-                                         }
-                                         catch (const std::exception &e)
+                                         if (!users.empty())
                                          {
-                                             Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
-                                         }
-                                     })));
-
-            router.add_route(http::verb::get, "/users/{id}",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [self](const std::unordered_map<std::string, std::string> &params,
-                                            http::response<http::string_body> &res)
-                                     {
-                                         try
-                                         {
-                                             std::stringstream ss(params.at("id"));
-                                             int id{};
-                                             ss >> id;
-                                             auto user = self->get_user_by_id(id);
-
-                                             if (user)
+                                             nlohmann::json users_json = nlohmann::json::array();
+                                             for (const auto &user : users)
                                              {
-                                                 Softadastra::Response::json_response(res, user->to_json());
-                                             }
-                                             else
-                                             {
-                                                 Softadastra::Response::error_response(res, http::status::not_found, "User not found");
+                                                 users_json.push_back(user.to_json());
                                              }
+                                             Response::json_response(res, users_json);
                                          }
-                                         catch (const std::exception &e)
+                                         else
                                          {
-                                             Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                             Softadastra::Response::no_content_response(res, "No users found");
                                          }
-                                     })));
+                                     }
+                                     catch (const std::exception &e)
+                                     {
+                                         Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                     }
+                                 }),
+                             ExecutionPolicy::Blocking);
+
+            add_typed_route<by_id>(router, http::verb::get,
+                                   [self](const http::request<http::string_body> &req, std::int64_t id,
+                                          http::response<http::string_body> &res)
+                                   {
+                                       try
+                                       {
+                                           auto user = self->get_user_by_id(static_cast<int>(id));
+
+                                           if (user)
+                                           {
+                                               // Le client a déjà cette version : 304, sans sérialiser.
+                                               if (Softadastra::Response::not_modified(req, res, user->version()))
+                                               {
+                                                   return;
+                                               }
+                                               Softadastra::Response::json_response(res, user->to_json());
+                                           }
+                                           else
+                                           {
+                                               Softadastra::Response::error_response(res, http::status::not_found, "User not found");
+                                           }
+                                       }
+                                       catch (const std::exception &e)
+                                       {
+                                           Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                       }
+                                   },
+                                   ExecutionPolicy::Blocking);
 
             router.add_route(http::verb::post, "/create",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [self](const std::unordered_map<std::string, std::string> &params,
-                                            http::response<http::string_body> &res)
+                             DynamicRequestHandler(
+                                 [self](const http::request<http::string_body> &req,
+                                        const RouteParams &,
+                                        http::response<http::string_body> &res)
+                                 {
+                                     try
                                      {
+                                         json request_json;
                                          try
                                          {
-                                             json request_json;
-                                             try
-                                             {
-                                                 request_json = json::parse(params.at("body"));
-                                             }
-                                             catch (const std::exception &e)
-                                             {
-                                                 Response::error_response(res, http::status::bad_request, "Inavlid JSON body");
-                                                 return;
-                                             }
-
-                                             if (request_json.find("firstname") == request_json.end())
-                                             {
-                                                 Response::error_response(res, http::status::bad_request, "Le champ 'firstname' est manquant.");
-                                                 return;
-                                             }
-                                             if (request_json.find("email") == request_json.end())
-                                             {
-                                                 Response::error_response(res, http::status::bad_request, "Le champ 'email' est manquant.");
-                                                 return;
-                                             }
-
-                                             User new_user = self->createUser(request_json["firstname"], request_json["email"]);
-                                             Response::create_response(res, http::status::created, "User created successfully");
-                                         }
-                                         catch (const nlohmann::json::exception &e)
-                                         {
-                                             Response::error_response(res, http::status::bad_request, "Invalid JSON format");
+                                             request_json = json::parse(req.body());
                                          }
                                          catch (const std::exception &e)
                                          {
-                                             Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                             Response::error_response(res, http::status::bad_request, "Inavlid JSON body");
+                                             return;
                                          }
-                                     })));
 
-            router.add_route(http::verb::put, "/update/{id}",
-                             std::static_pointer_cast<IRequestHandler>(
-                                 std::make_shared<DynamicRequestHandler>(
-                                     [self](const std::unordered_map<std::string, std::string> &params,
-                                            http::response<http::string_body> &res)
-                                     {
-                                         try
+                                         if (request_json.find("firstname") == request_json.end())
                                          {
-                                             std::stringstream ss(params.at("id"));
-                                             int id{};
-                                             ss >> id;
-
-                                             json request_json;
-                                             try
-                                             {
-                                                 request_json = json::parse(params.at("body"));
-                                             }
-                                             catch (const std::exception &e)
-                                             {
-                                                 Response::error_response(res, http::status::bad_request, "Invalid JSON body");
-                                                 return;
-                                             }
-
-                                             if (request_json.find("firstname") == request_json.end())
-                                             {
-                                                 Response::error_response(res, http::status::bad_request, "Le champ 'firstname' est manquant.");
-                                                 return;
-                                             }
-                                             if (request_json.find("email") == request_json.end())
-                                             {
-                                                 Response::error_response(res, http::status::bad_request, "Le champ 'email' est manquant.");
-                                                 return;
-                                             }
-
-                                             User updated_user = self->updateUser(id, request_json["firstname"], request_json["email"]);
-
-                                             Softadastra::Response::json_response(res, updated_user.to_json());
+                                             Response::error_response(res, http::status::bad_request, "Le champ 'firstname' est manquant.");
+                                             return;
                                          }
-                                         catch (const std::exception &e)
+                                         if (request_json.find("email") == request_json.end())
                                          {
-                                             Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                             Response::error_response(res, http::status::bad_request, "Le champ 'email' est manquant.");
+                                             return;
                                          }
-                                     })));
+
+                                         User new_user = self->createUser(request_json["firstname"], request_json["email"]);
+                                         Response::create_response(res, http::status::created, "User created successfully");
+                                     }
+                                     catch (const nlohmann::json::exception &e)
+                                     {
+                                         Response::error_response(res, http::status::bad_request, "Invalid JSON format");
+                                     }
+                                     catch (const std::exception &e)
+                                     {
+                                         Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                     }
+                                 }),
+                             ExecutionPolicy::Blocking);
+
+            add_typed_route<update_by_id>(router, http::verb::put,
+                                          [self](const http::request<http::string_body> &req, std::int64_t id,
+                                                 http::response<http::string_body> &res)
+                                          {
+                                              try
+                                              {
+                                                  json request_json;
+                                                  try
+                                                  {
+                                                      request_json = json::parse(req.body());
+                                                  }
+                                                  catch (const std::exception &e)
+                                                  {
+                                                      Response::error_response(res, http::status::bad_request, "Invalid JSON body");
+                                                      return;
+                                                  }
+
+                                                  if (request_json.find("firstname") == request_json.end())
+                                                  {
+                                                      Response::error_response(res, http::status::bad_request, "Le champ 'firstname' est manquant.");
+                                                      return;
+                                                  }
+                                                  if (request_json.find("email") == request_json.end())
+                                                  {
+                                                      Response::error_response(res, http::status::bad_request, "Le champ 'email' est manquant.");
+                                                      return;
+                                                  }
+
+                                                  User updated_user = self->updateUser(static_cast<int>(id), request_json["firstname"], request_json["email"]);
+
+                                                  Softadastra::Response::json_response(res, updated_user.to_json());
+                                              }
+                                              catch (const std::exception &e)
+                                              {
+                                                  Softadastra::Response::error_response(res, http::status::internal_server_error, e.what());
+                                              }
+                                          },
+                                          ExecutionPolicy::Blocking);
         }
 
     public:
@@ -1,4 +1,5 @@
 #include "Config.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -14,7 +15,51 @@ Config::Config()
       db_pass(),
       db_name("http_db"),
       db_port(3306),
-      server_port(8080)
+      server_port(8080),
+      io_model("shared"),
+      io_threads(0),
+      io_backend("epoll"),
+      read_timeout(20),
+      keep_alive_timeout(5),
+      write_timeout(20),
+      max_keep_alive_requests(100),
+      cpu_threads(0),
+      blocking_threads(16),
+      session_pool_max_sessions(1024),
+      session_pool_max_bytes(16 * 1024 * 1024),
+      status_endpoint(),
+      max_connections(0),
+      max_queued_requests(0),
+      overload_action("reject"),
+      retry_after(1),
+      tls_enabled(false),
+      tls_certificate_file(),
+      tls_private_key_file(),
+      tls_session_cache_size(20480),
+      tls_session_timeout(300),
+      tls_ticket_key_rotation(3600),
+      tls_ktls(false),
+      static_root(),
+      static_prefix("/app/"),
+      static_index("index.html"),
+      static_max_open_files(1024),
+      static_revalidate(2),
+      static_assets(),
+      compression_enabled(true),
+      compression_min_size(1024),
+      compression_level(6),
+      compression_min_level(1),
+      compression_saturation_queue(64),
+      compression_zstd(true),
+      cache_enabled(false),
+      cache_max_entries(10000),
+      cache_max_body_size(1024 * 1024),
+      cache_routes(),
+      middleware_global({"waf", "cors"}),
+      middleware_routes(),
+      log_level("info"),
+      log_queue_size(8192),
+      log_access_sample_rate(1.0)
 {
 }
 
@@ -55,11 +100,141 @@ void Config::loadConfig()
         db_pass = config.at("database").at("password").get<std::string>();
         db_name = config.at("database").at("name").get<std::string>();
         server_port = config.at("server").at("port").get<int>();
+        io_model = config.at("server").value("io_model", "shared");
+        io_threads = config.at("server").value("io_threads", 0);
+        io_backend = config.at("server").value("io_backend", "epoll");
+        read_timeout = config.at("server").value("read_timeout", 20);
+        keep_alive_timeout = config.at("server").value("keep_alive_timeout", 5);
+        write_timeout = config.at("server").value("write_timeout", 20);
+        max_keep_alive_requests = config.at("server").value("max_keep_alive_requests", 100);
+        cpu_threads = config.at("server").value("cpu_threads", 0);
+        blocking_threads = config.at("server").value("blocking_threads", 16);
+        session_pool_max_sessions = config.at("server").value("session_pool_max_sessions", 1024);
+        session_pool_max_bytes = config.at("server").value("session_pool_max_bytes", 16 * 1024 * 1024);
+        status_endpoint = config.at("server").value("status_endpoint", "");
+
+        if (config.contains("admission"))
+        {
+            const json &admission = config.at("admission");
+            max_connections = admission.value("max_connections", 0);
+            max_queued_requests = admission.value("max_queued_requests", 0);
+            overload_action = admission.value("overload_action", "reject");
+            retry_after = admission.value("retry_after", 1);
+        }
+
+        if (config.contains("tls"))
+        {
+            const json &tls = config.at("tls");
+            tls_enabled = tls.value("enabled", false);
+            tls_certificate_file = tls.value("certificate_file", "");
+            tls_private_key_file = tls.value("private_key_file", "");
+            tls_session_cache_size = tls.value("session_cache_size", 20480);
+            tls_session_timeout = tls.value("session_timeout", 300);
+            tls_ticket_key_rotation = tls.value("ticket_key_rotation", 3600);
+            tls_ktls = tls.value("ktls", false);
+        }
+
+        if (config.contains("static"))
+        {
+            const json &files = config.at("static");
+            static_root = files.value("root", "");
+            static_prefix = files.value("prefix", "/app/");
+            static_index = files.value("index", "index.html");
+            static_max_open_files = files.value("max_open_files", 1024);
+            static_revalidate = files.value("revalidate", 2);
+            static_assets = files.value("assets", "");
+        }
+
+        if (config.contains("compression"))
+        {
+            const json &compression = config.at("compression");
+            compression_enabled = compression.value("enabled", true);
+            compression_min_size = compression.value("min_size", 1024);
+            compression_level = compression.value("level", 6);
+            compression_min_level = compression.value("min_level", 1);
+            compression_saturation_queue = compression.value("saturation_queue", 64);
+            compression_zstd = compression.value("zstd", true);
+        }
+
+        if (config.contains("cache"))
+        {
+            const json &cache = config.at("cache");
+            cache_enabled = cache.value("enabled", false);
+            cache_max_entries = cache.value("max_entries", 10000);
+            cache_max_body_size = cache.value("max_body_size", 1024 * 1024);
+            cache_routes.clear();
+            if (cache.contains("routes"))
+            {
+                for (const auto &[route, entry] : cache.at("routes").items())
+                {
+                    CacheRouteConfig route_config;
+                    route_config.ttl_ms = entry.value("ttl_ms", 1000);
+                    route_config.stale_ms = entry.value("stale_ms", 0);
+                    route_config.vary = entry.value("vary", std::vector<std::string>());
+                    if (route_config.ttl_ms <= 0 || route_config.stale_ms < 0)
+                    {
+                        throw std::runtime_error("Valeur invalide pour cache.routes." + route + " (ttl_ms > 0 et stale_ms >= 0 attendus)");
+                    }
+                    cache_routes.emplace(route, std::move(route_config));
+                }
+            }
+        }
+
+        if (config.contains("middleware"))
+        {
+            const json &middleware = config.at("middleware");
+            middleware_global = middleware.value("global", std::vector<std::string>{"waf", "cors"});
+            middleware_routes = middleware.value("routes", std::unordered_map<std::string, std::vector<std::string>>());
+        }
+
+        if (config.contains("logging"))
+        {
+            const json &logging = config.at("logging");
+            log_level = logging.value("level", "info");
+            log_queue_size = logging.value("queue_size", 8192);
+            log_access_sample_rate = logging.value("access_sample_rate", 1.0);
+        }
     }
     catch (const json::type_error &e)
     {
         throw std::runtime_error("Types incorrects dans le fichier JSON : " + std::string(e.what()));
     }
+
+    if (io_model != "shared" && io_model != "sharded")
+    {
+        throw std::runtime_error("Valeur invalide pour server.io_model : " + io_model + " (attendu : shared ou sharded)");
+    }
+
+    if (io_backend != "epoll" && io_backend != "io_uring")
+    {
+        throw std::runtime_error("Valeur invalide pour server.io_backend : " + io_backend + " (attendu : epoll ou io_uring)");
+    }
+
+    if (overload_action != "reject" && overload_action != "pause")
+    {
+        throw std::runtime_error("Valeur invalide pour admission.overload_action : " + overload_action + " (attendu : reject ou pause)");
+    }
+
+    if (tls_enabled && (tls_certificate_file.empty() || tls_private_key_file.empty()))
+    {
+        throw std::runtime_error("tls.certificate_file et tls.private_key_file sont requis quand tls.enabled vaut true");
+    }
+
+    static const std::vector<std::string> log_levels = {"trace", "debug", "info", "warn", "error", "critical", "off"};
+    if (std::find(log_levels.begin(), log_levels.end(), log_level) == log_levels.end())
+    {
+        throw std::runtime_error("Valeur invalide pour logging.level : " + log_level + " (attendu : trace, debug, info, warn, error, critical ou off)");
+    }
+
+    if (log_queue_size < 1 || log_access_sample_rate < 0.0 || log_access_sample_rate > 1.0)
+    {
+        throw std::runtime_error("Valeur invalide pour logging (queue_size >= 1 et access_sample_rate entre 0 et 1 attendus)");
+    }
+
+    if (!static_root.empty() && (static_prefix.empty() || static_prefix.front() != '/' || static_prefix.back() != '/'))
+    {
+        throw std::runtime_error("Valeur invalide pour static.prefix : " + static_prefix + " (doit commencer et finir par /)");
+    }
 }
 
 std::shared_ptr<sql::Connection> Config::getDbConnection()
@@ -113,6 +288,50 @@ const std::string &Config::getDbUser() const { return db_user; }
 const std::string &Config::getDbName() const { return db_name; }
 int Config::getDbPort() const { return db_port; }
 int Config::getServerPort() const { return server_port; }
+const std::string &Config::getIoModel() const { return io_model; }
+int Config::getIoThreads() const { return io_threads; }
+const std::string &Config::getIoBackend() const { return io_backend; }
+int Config::getReadTimeout() const { return read_timeout; }
+int Config::getKeepAliveTimeout() const { return keep_alive_timeout; }
+int Config::getWriteTimeout() const { return write_timeout; }
+int Config::getMaxKeepAliveRequests() const { return max_keep_alive_requests; }
+int Config::getCpuThreads() const { return cpu_threads; }
+int Config::getBlockingThreads() const { return blocking_threads; }
+int Config::getSessionPoolMaxSessions() const { return session_pool_max_sessions; }
+int Config::getSessionPoolMaxBytes() const { return session_pool_max_bytes; }
+const std::string &Config::getStatusEndpoint() const { return status_endpoint; }
+int Config::getMaxConnections() const { return max_connections; }
+int Config::getMaxQueuedRequests() const { return max_queued_requests; }
+const std::string &Config::getOverloadAction() const { return overload_action; }
+int Config::getRetryAfter() const { return retry_after; }
+bool Config::getTlsEnabled() const { return tls_enabled; }
+const std::string &Config::getTlsCertificateFile() const { return tls_certificate_file; }
+const std::string &Config::getTlsPrivateKeyFile() const { return tls_private_key_file; }
+int Config::getTlsSessionCacheSize() const { return tls_session_cache_size; }
+int Config::getTlsSessionTimeout() const { return tls_session_timeout; }
+int Config::getTlsTicketKeyRotation() const { return tls_ticket_key_rotation; }
+bool Config::getTlsKtls() const { return tls_ktls; }
+const std::string &Config::getStaticRoot() const { return static_root; }
+const std::string &Config::getStaticPrefix() const { return static_prefix; }
+const std::string &Config::getStaticIndex() const { return static_index; }
+int Config::getStaticMaxOpenFiles() const { return static_max_open_files; }
+int Config::getStaticRevalidate() const { return static_revalidate; }
+const std::string &Config::getStaticAssets() const { return static_assets; }
+bool Config::getCompressionEnabled() const { return compression_enabled; }
+int Config::getCompressionMinSize() const { return compression_min_size; }
+int Config::getCompressionLevel() const { return compression_level; }
+int Config::getCompressionMinLevel() const { return compression_min_level; }
+int Config::getCompressionSaturationQueue() const { return compression_saturation_queue; }
+bool Config::getCompressionZstd() const { return compression_zstd; }
+bool Config::getCacheEnabled() const { return cache_enabled; }
+int Config::getCacheMaxEntries() const { return cache_max_entries; }
+int Config::getCacheMaxBodySize() const { return cache_max_body_size; }
+const std::unordered_map<std::string, CacheRouteConfig> &Config::getCacheRoutes() const { return cache_routes; }
+const std::vector<std::string> &Config::getMiddlewareGlobal() const { return middleware_global; }
+const std::unordered_map<std::string, std::vector<std::string>> &Config::getMiddlewareRoutes() const { return middleware_routes; }
+const std::string &Config::getLogLevel() const { return log_level; }
+int Config::getLogQueueSize() const { return log_queue_size; }
+double Config::getLogAccessSampleRate() const { return log_access_sample_rate; }
 
 Config &Config::getInstance()
 {
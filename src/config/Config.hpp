@@ -12,6 +12,17 @@
 #include <cstdlib>
 #include <memory>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Micro-cache d'une route (section "cache.routes", clé : motif de la route).
+struct CacheRouteConfig
+{
+    int ttl_ms = 1000;               // réponse servie sans recalcul
+    int stale_ms = 0;                // au-delà du ttl : servie périmée pendant le recalcul
+    std::vector<std::string> vary;   // en-têtes de requête qui font partie de la clé
+};
 
 class Config
 {
@@ -29,6 +40,50 @@ public:
     const std::string &getDbName() const;
     int getDbPort() const;
     int getServerPort() const;
+    const std::string &getIoModel() const;
+    int getIoThreads() const;
+    const std::string &getIoBackend() const;
+    int getReadTimeout() const;
+    int getKeepAliveTimeout() const;
+    int getWriteTimeout() const;
+    int getMaxKeepAliveRequests() const;
+    int getCpuThreads() const;
+    int getBlockingThreads() const;
+    int getSessionPoolMaxSessions() const;
+    int getSessionPoolMaxBytes() const;
+    const std::string &getStatusEndpoint() const;
+    int getMaxConnections() const;
+    int getMaxQueuedRequests() const;
+    const std::string &getOverloadAction() const;
+    int getRetryAfter() const;
+    bool getTlsEnabled() const;
+    const std::string &getTlsCertificateFile() const;
+    const std::string &getTlsPrivateKeyFile() const;
+    int getTlsSessionCacheSize() const;
+    int getTlsSessionTimeout() const;
+    int getTlsTicketKeyRotation() const;
+    bool getTlsKtls() const;
+    const std::string &getStaticRoot() const;
+    const std::string &getStaticPrefix() const;
+    const std::string &getStaticIndex() const;
+    int getStaticMaxOpenFiles() const;
+    int getStaticRevalidate() const;
+    const std::string &getStaticAssets() const;
+    bool getCompressionEnabled() const;
+    int getCompressionMinSize() const;
+    int getCompressionLevel() const;
+    int getCompressionMinLevel() const;
+    int getCompressionSaturationQueue() const;
+    bool getCompressionZstd() const;
+    bool getCacheEnabled() const;
+    int getCacheMaxEntries() const;
+    int getCacheMaxBodySize() const;
+    const std::unordered_map<std::string, CacheRouteConfig> &getCacheRoutes() const;
+    const std::vector<std::string> &getMiddlewareGlobal() const;
+    const std::unordered_map<std::string, std::vector<std::string>> &getMiddlewareRoutes() const;
+    const std::string &getLogLevel() const;
+    int getLogQueueSize() const;
+    double getLogAccessSampleRate() const;
 
 private:
     std::string db_host;
@@ -37,6 +92,50 @@ private:
     std::string db_name;
     int db_port;
     int server_port;
+    std::string io_model;
+    int io_threads;
+    std::string io_backend;
+    int read_timeout;
+    int keep_alive_timeout;
+    int write_timeout;
+    int max_keep_alive_requests;
+    int cpu_threads;
+    int blocking_threads;
+    int session_pool_max_sessions;
+    int session_pool_max_bytes;
+    std::string status_endpoint; // vide par défaut : compteurs internes sans contrôle d'accès
+    int max_connections;
+    int max_queued_requests;
+    std::string overload_action;
+    int retry_after;
+    bool tls_enabled;
+    std::string tls_certificate_file;
+    std::string tls_private_key_file;
+    int tls_session_cache_size;
+    int tls_session_timeout;
+    int tls_ticket_key_rotation;
+    bool tls_ktls;
+    std::string static_root; // vide : pas de fichiers statiques
+    std::string static_prefix;
+    std::string static_index;
+    int static_max_open_files;
+    int static_revalidate;
+    std::string static_assets; // sortie de la cible "assets" (manifest.json) ; prioritaire sur root
+    bool compression_enabled;
+    int compression_min_size;
+    int compression_level;
+    int compression_min_level;
+    int compression_saturation_queue;
+    bool compression_zstd;
+    bool cache_enabled;
+    int cache_max_entries;
+    int cache_max_body_size;
+    std::unordered_map<std::string, CacheRouteConfig> cache_routes;
+    std::vector<std::string> middleware_global;                                   // toutes les routes, en premier
+    std::unordered_map<std::string, std::vector<std::string>> middleware_routes; // clé : motif de la route
+    std::string log_level;
+    int log_queue_size;
+    double log_access_sample_rate; // 0 : pas de journal d'accès, 1 : toutes les requêtes
 };
 
 #endif // CONFIG_HPP
@@ -3,6 +3,8 @@
 #include "Controllers/UserController.hpp"
 #include "Controllers/HomeController.hpp"
 #include "Controllers/TestController.hpp"
+#include <algorithm>
+#include <filesystem>
 #include <memory>
 
 namespace Softadastra
@@ -28,6 +30,57 @@ namespace Softadastra
 
         std::unique_ptr<TestController> testController = std::make_unique<TestController>(config);
         testController->configure(router_);
+
+        if (!config.getStaticRoot().empty())
+        {
+            StaticFiles::Options options;
+            options.root = config.getStaticRoot();
+            options.prefix = config.getStaticPrefix();
+            options.index = config.getStaticIndex();
+            options.max_open_files = static_cast<std::size_t>(std::max(1, config.getStaticMaxOpenFiles()));
+            options.revalidate = std::chrono::seconds(std::max(0, config.getStaticRevalidate()));
+
+            // Fichiers précompressés par la cible "assets" s'ils ont été générés, sinon
+            // frontend/ tel quel (ni compression ni cache long côté client).
+            const std::string &assets = config.getStaticAssets();
+            if (!assets.empty() && std::filesystem::exists(assets + "/manifest.json"))
+            {
+                options.root = assets;
+                options.manifest = "manifest.json";
+            }
+            else if (!assets.empty())
+            {
+                spdlog::warn("No asset manifest in {} (build the \"assets\" target), serving {} as is",
+                             assets, options.root);
+            }
+            router_.mount_static(std::make_shared<StaticFiles>(options));
+        }
+    }
+
+    void RouteConfigurator::configure_middleware()
+    {
+        Config &config = Config::getInstance();
+        router_.register_middleware(waf_middleware());
+        router_.register_middleware(cors_middleware());
+
+        try
+        {
+            for (const std::string &name : config.getMiddlewareGlobal())
+            {
+                router_.use_middleware(name);
+            }
+            for (const auto &[pattern, names] : config.getMiddlewareRoutes())
+            {
+                for (const std::string &name : names)
+                {
+                    router_.use_middleware(name, pattern);
+                }
+            }
+        }
+        catch (const std::invalid_argument &e)
+        {
+            throw std::runtime_error("Valeur invalide dans la section middleware : " + std::string(e.what()));
+        }
     }
 
 }
@@ -4,7 +4,6 @@
 #include "routing/Router.hpp"
 #include "routing/SimpleRequestHandler.hpp"
 #include "routing/DynamicRequestHandler.hpp"
-#include "routing/IRequestHandler.hpp"
 #include "Config.hpp"
 #include <unordered_map>
 #include <string>
@@ -17,6 +16,9 @@ namespace Softadastra
     public:
         explicit RouteConfigurator(Router &router);
         void configure_routes();
+        // Après toutes les routes (y compris /server-status) : chaînes de middlewares de
+        // la section "middleware", aplaties route par route.
+        void configure_middleware();
 
     private:
         Router &router_;
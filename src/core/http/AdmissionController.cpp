@@ -0,0 +1,108 @@
+#include "AdmissionController.hpp"
+
+namespace Softadastra
+{
+    namespace
+    {
+        std::string make_overload_response(std::chrono::seconds retry_after)
+        {
+            const std::string body = R"({"message":"Server overloaded, retry later"})";
+
+            std::string response = "HTTP/1.1 503 Service Unavailable\r\n";
+            response += "Content-Type: application/json\r\n";
+            response += "Server: Softadastra\r\n";
+            response += "Retry-After: " + std::to_string(retry_after.count()) + "\r\n";
+            response += "Connection: close\r\n";
+            response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+            response += body;
+            return response;
+        }
+    }
+
+    AdmissionController::AdmissionController(const Limits &limits)
+        : limits_(limits),
+          overload_response_(make_overload_response(limits.retry_after)),
+          active_connections_(0),
+          queued_requests_(0),
+          admitted_connections_(0),
+          rejected_connections_(0),
+          admitted_requests_(0),
+          rejected_requests_(0),
+          accept_pauses_(0)
+    {
+    }
+
+    bool AdmissionController::try_acquire(std::atomic<std::size_t> &counter, std::size_t limit)
+    {
+        if (limit == 0)
+        {
+            counter.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        std::size_t current = counter.load(std::memory_order_relaxed);
+        while (current < limit)
+        {
+            if (counter.compare_exchange_weak(current, current + 1, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool AdmissionController::try_admit_connection()
+    {
+        if (try_acquire(active_connections_, limits_.max_connections))
+        {
+            admitted_connections_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        rejected_connections_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void AdmissionController::release_connection()
+    {
+        active_connections_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool AdmissionController::connections_saturated() const
+    {
+        return limits_.max_connections != 0 &&
+               active_connections_.load(std::memory_order_relaxed) >= limits_.max_connections;
+    }
+
+    void AdmissionController::record_accept_pause()
+    {
+        accept_pauses_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool AdmissionController::try_enqueue_request()
+    {
+        if (try_acquire(queued_requests_, limits_.max_queued_requests))
+        {
+            admitted_requests_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        rejected_requests_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void AdmissionController::release_request()
+    {
+        queued_requests_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    AdmissionController::Stats AdmissionController::stats() const
+    {
+        return Stats{
+            admitted_connections_.load(std::memory_order_relaxed),
+            rejected_connections_.load(std::memory_order_relaxed),
+            admitted_requests_.load(std::memory_order_relaxed),
+            rejected_requests_.load(std::memory_order_relaxed),
+            accept_pauses_.load(std::memory_order_relaxed),
+            active_connections_.load(std::memory_order_relaxed),
+            queued_requests_.load(std::memory_order_relaxed)};
+    }
+}
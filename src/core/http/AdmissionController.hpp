@@ -0,0 +1,72 @@
+#ifndef ADMISSIONCONTROLLER_HPP
+#define ADMISSIONCONTROLLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Softadastra
+{
+    // Limite le nombre de connexions ouvertes et de requêtes en attente dans les pools.
+    // Tout est atomique : les décisions sont prises sur les threads io, sans verrou.
+    class AdmissionController
+    {
+    public:
+        enum class OverloadAction
+        {
+            Reject, // accepter puis répondre 503 + Retry-After immédiatement
+            Pause   // cesser d'appeler accept() tant que la limite est atteinte
+        };
+
+        struct Limits
+        {
+            std::size_t max_connections = 0;     // 0 : illimité
+            std::size_t max_queued_requests = 0; // requêtes confiées aux pools (CpuPool/Blocking)
+            OverloadAction action = OverloadAction::Reject;
+            std::chrono::seconds retry_after{1};
+        };
+
+        struct Stats
+        {
+            std::uint64_t admitted_connections;
+            std::uint64_t rejected_connections;
+            std::uint64_t admitted_requests;
+            std::uint64_t rejected_requests;
+            std::uint64_t accept_pauses;
+            std::size_t active_connections;
+            std::size_t queued_requests;
+        };
+
+        explicit AdmissionController(const Limits &limits);
+
+        bool try_admit_connection();
+        void release_connection();
+        bool connections_saturated() const;
+        void record_accept_pause();
+
+        bool try_enqueue_request();
+        void release_request();
+        std::size_t queued_requests() const { return queued_requests_.load(std::memory_order_relaxed); }
+
+        const Limits &limits() const { return limits_; }
+        // Réponse 503 complète, prête à être écrite telle quelle sur une socket refusée.
+        const std::string &overload_response() const { return overload_response_; }
+        Stats stats() const;
+
+    private:
+        static bool try_acquire(std::atomic<std::size_t> &counter, std::size_t limit);
+
+        const Limits limits_;
+        const std::string overload_response_;
+        std::atomic<std::size_t> active_connections_;
+        std::atomic<std::size_t> queued_requests_;
+        std::atomic<std::uint64_t> admitted_connections_;
+        std::atomic<std::uint64_t> rejected_connections_;
+        std::atomic<std::uint64_t> admitted_requests_;
+        std::atomic<std::uint64_t> rejected_requests_;
+        std::atomic<std::uint64_t> accept_pauses_;
+    };
+}
+
+#endif // ADMISSIONCONTROLLER_HPP
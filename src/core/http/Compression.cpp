@@ -0,0 +1,283 @@
+#include "Compression.hpp"
+#include "ETag.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <ctime>
+#include <memory>
+
+#ifdef SOFTADASTRA_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace Softadastra
+{
+    namespace
+    {
+        std::uint64_t thread_cpu_us()
+        {
+            timespec ts{};
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return static_cast<std::uint64_t>(ts.tv_sec) * 1000000 + static_cast<std::uint64_t>(ts.tv_nsec) / 1000;
+        }
+
+        // Un z_stream par thread et par format, réinitialisé plutôt que réalloué
+        // (deflateInit2 alloue ~256 Ko).
+        struct Deflater
+        {
+            explicit Deflater(int window_bits)
+                : stream(), level(Z_DEFAULT_COMPRESSION),
+                  ready(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) == Z_OK)
+            {
+            }
+            ~Deflater()
+            {
+                if (ready)
+                {
+                    deflateEnd(&stream);
+                }
+            }
+            Deflater(const Deflater &) = delete;
+            Deflater &operator=(const Deflater &) = delete;
+
+            z_stream stream;
+            int level;
+            bool ready;
+        };
+
+        bool deflate_into(Deflater &deflater, int level, const std::string &input, std::string &output)
+        {
+            if (!deflater.ready || deflateReset(&deflater.stream) != Z_OK)
+            {
+                return false;
+            }
+            if (level != deflater.level)
+            {
+                // Flux tout juste réinitialisé : rien à vider, deflateParams ne fait que changer de niveau.
+                if (deflateParams(&deflater.stream, level, Z_DEFAULT_STRATEGY) != Z_OK)
+                {
+                    return false;
+                }
+                deflater.level = level;
+            }
+
+            output.resize(deflateBound(&deflater.stream, static_cast<uLong>(input.size())));
+            deflater.stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+            deflater.stream.avail_in = static_cast<uInt>(input.size());
+            deflater.stream.next_out = reinterpret_cast<Bytef *>(output.data());
+            deflater.stream.avail_out = static_cast<uInt>(output.size());
+            if (deflate(&deflater.stream, Z_FINISH) != Z_STREAM_END)
+            {
+                return false;
+            }
+            output.resize(deflater.stream.total_out);
+            return true;
+        }
+    }
+
+    bool accepts_encoding(boost::beast::string_view header, boost::beast::string_view encoding)
+    {
+        while (!header.empty())
+        {
+            const std::size_t comma = header.find(',');
+            boost::beast::string_view element = header.substr(0, comma);
+            header = comma == boost::beast::string_view::npos ? boost::beast::string_view() : header.substr(comma + 1);
+
+            const std::size_t semicolon = element.find(';');
+            boost::beast::string_view name = element.substr(0, semicolon);
+            while (!name.empty() && name.front() == ' ')
+            {
+                name.remove_prefix(1);
+            }
+            while (!name.empty() && name.back() == ' ')
+            {
+                name.remove_suffix(1);
+            }
+            if (!boost::beast::iequals(name, encoding))
+            {
+                continue;
+            }
+
+            if (semicolon != boost::beast::string_view::npos)
+            {
+                const boost::beast::string_view params = element.substr(semicolon + 1);
+                const std::size_t q = params.find("q=");
+                if (q != boost::beast::string_view::npos)
+                {
+                    // q=0, q=0.0, q=0.000 : tous les chiffres qui suivent sont des zéros.
+                    bool zero = true;
+                    for (std::size_t i = q + 2; i < params.size() && params[i] != ' ' && params[i] != ';'; ++i)
+                    {
+                        zero = zero && (params[i] == '0' || params[i] == '.');
+                    }
+                    return !zero;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    ResponseCompressor::ResponseCompressor(const Options &options, const AdmissionController &admission)
+        : options_(options), admission_(admission), stats_mutex_(), stats_()
+    {
+    }
+
+    int ResponseCompressor::current_level() const
+    {
+        // Interpolation linéaire entre level (pools vides) et min_level (saturation_queue
+        // requêtes en attente ou plus).
+        const std::size_t queued = admission_.queued_requests();
+        if (options_.saturation_queue == 0 || queued >= options_.saturation_queue)
+        {
+            return options_.min_level;
+        }
+        const int span = options_.level - options_.min_level;
+        return options_.level - static_cast<int>(span * static_cast<long>(queued) / static_cast<long>(options_.saturation_queue));
+    }
+
+    ResponseCompressor::Encoding ResponseCompressor::negotiate(boost::beast::string_view accept_encoding) const
+    {
+        if (accept_encoding.empty())
+        {
+            return Encoding::None;
+        }
+#ifdef SOFTADASTRA_HAS_ZSTD
+        if (options_.zstd && accepts_encoding(accept_encoding, "zstd"))
+        {
+            return Encoding::Zstd;
+        }
+#endif
+        if (accepts_encoding(accept_encoding, "gzip"))
+        {
+            return Encoding::Gzip;
+        }
+        if (accepts_encoding(accept_encoding, "deflate"))
+        {
+            return Encoding::Deflate;
+        }
+        return Encoding::None;
+    }
+
+    bool ResponseCompressor::compressible(const http::response<http::string_body> &res)
+    {
+        const unsigned status = res.result_int();
+        if (status < 200 || status == 204 || status == 304)
+        {
+            return false;
+        }
+        if (res.count(http::field::content_encoding) != 0)
+        {
+            return false;
+        }
+        const auto cache_control = res[http::field::cache_control];
+        if (cache_control.find("no-transform") != boost::beast::string_view::npos)
+        {
+            return false;
+        }
+
+        // Formats déjà compressés (images, archives...) exclus.
+        const auto type = res[http::field::content_type];
+        return type.starts_with("text/") || type.starts_with("application/json") ||
+               type.starts_with("application/javascript") || type.starts_with("application/xml") ||
+               type.starts_with("image/svg+xml");
+    }
+
+    bool ResponseCompressor::encode(Encoding encoding, int level, const std::string &input, std::string &output)
+    {
+        switch (encoding)
+        {
+        case Encoding::Gzip:
+        {
+            thread_local Deflater gzip(15 + 16);
+            return deflate_into(gzip, level, input, output);
+        }
+        case Encoding::Deflate:
+        {
+            // "deflate" en HTTP désigne le format zlib (RFC 1950), pas le deflate brut.
+            thread_local Deflater zlib(15);
+            return deflate_into(zlib, level, input, output);
+        }
+        case Encoding::Zstd:
+        {
+#ifdef SOFTADASTRA_HAS_ZSTD
+            thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx *)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+            if (!context)
+            {
+                return false;
+            }
+            output.resize(ZSTD_compressBound(input.size()));
+            const std::size_t size = ZSTD_compressCCtx(context.get(), output.data(), output.size(), input.data(), input.size(), level);
+            if (ZSTD_isError(size))
+            {
+                return false;
+            }
+            output.resize(size);
+            return true;
+#else
+            return false;
+#endif
+        }
+        case Encoding::None:
+            break;
+        }
+        return false;
+    }
+
+    void ResponseCompressor::compress(const http::request<http::string_body> &req, http::response<http::string_body> &res,
+                                      const std::string &route)
+    {
+        if (!options_.enabled || res.body().size() < options_.min_size || !compressible(res))
+        {
+            return;
+        }
+        const Encoding encoding = negotiate(req[http::field::accept_encoding]);
+        if (encoding == Encoding::None)
+        {
+            return;
+        }
+
+        const std::uint64_t start = thread_cpu_us();
+        std::string output;
+        const bool encoded = encode(encoding, current_level(), res.body(), output);
+        const std::uint64_t cpu_us = thread_cpu_us() - start;
+
+        const std::size_t bytes_in = res.body().size();
+        if (!encoded || output.size() >= bytes_in)
+        {
+            // Incompressible : on garde le corps d'origine, le temps passé reste compté.
+            record(route, bytes_in, bytes_in, cpu_us);
+            return;
+        }
+
+        const char *name = encoding == Encoding::Zstd ? "zstd" : encoding == Encoding::Gzip ? "gzip" : "deflate";
+        res.body() = std::move(output);
+        res.set(http::field::content_encoding, name);
+        tag_encoding(res, name);
+        const auto vary = res[http::field::vary];
+        if (vary.empty())
+        {
+            res.set(http::field::vary, "Accept-Encoding");
+        }
+        else if (vary.find("Accept-Encoding") == boost::beast::string_view::npos)
+        {
+            res.set(http::field::vary, std::string(vary) + ", Accept-Encoding");
+        }
+        record(route, bytes_in, res.body().size(), cpu_us);
+    }
+
+    void ResponseCompressor::record(const std::string &route, std::size_t bytes_in, std::size_t bytes_out, std::uint64_t cpu_us)
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        RouteStats &stats = stats_[route];
+        ++stats.responses;
+        stats.bytes_in += bytes_in;
+        stats.bytes_out += bytes_out;
+        stats.cpu_us += cpu_us;
+    }
+
+    std::unordered_map<std::string, ResponseCompressor::RouteStats> ResponseCompressor::stats() const
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return stats_;
+    }
+}
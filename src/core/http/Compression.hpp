@@ -0,0 +1,73 @@
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http.hpp>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "AdmissionController.hpp"
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Accept-Encoding: "gzip, deflate, br;q=0.5" ; un codage à q=0 est refusé.
+    bool accepts_encoding(boost::beast::string_view header, boost::beast::string_view encoding);
+
+    // Compression des réponses dynamiques (zstd si disponible, gzip, deflate), appliquée
+    // sur le thread qui a exécuté le handler. Le niveau baisse quand les pools saturent :
+    // sous charge, mieux vaut quelques octets de plus qu'une file qui s'allonge.
+    class ResponseCompressor
+    {
+    public:
+        struct Options
+        {
+            bool enabled = true;
+            std::size_t min_size = 1024; // en dessous, l'en-tête gzip et le CPU coûtent plus qu'ils ne rapportent
+            int level = 6;               // pools au repos
+            int min_level = 1;           // pools saturés
+            std::size_t saturation_queue = 64; // requêtes en attente dans les pools pour atteindre min_level
+            bool zstd = true;
+        };
+
+        struct RouteStats
+        {
+            std::uint64_t responses = 0;
+            std::uint64_t bytes_in = 0;
+            std::uint64_t bytes_out = 0;
+            std::uint64_t cpu_us = 0; // temps CPU du thread passé à compresser
+        };
+
+        ResponseCompressor(const Options &options, const AdmissionController &admission);
+
+        // Compresse res.body() en place si le client l'accepte et si le corps s'y prête.
+        void compress(const http::request<http::string_body> &req, http::response<http::string_body> &res,
+                      const std::string &route);
+        int current_level() const;
+        std::unordered_map<std::string, RouteStats> stats() const;
+
+    private:
+        enum class Encoding
+        {
+            None,
+            Zstd,
+            Gzip,
+            Deflate
+        };
+
+        Encoding negotiate(boost::beast::string_view accept_encoding) const;
+        static bool compressible(const http::response<http::string_body> &res);
+        static bool encode(Encoding encoding, int level, const std::string &input, std::string &output);
+        void record(const std::string &route, std::size_t bytes_in, std::size_t bytes_out, std::uint64_t cpu_us);
+
+        const Options options_;
+        const AdmissionController &admission_;
+        mutable std::mutex stats_mutex_;
+        std::unordered_map<std::string, RouteStats> stats_;
+    };
+}
+
+#endif // COMPRESSION_HPP
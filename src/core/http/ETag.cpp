@@ -0,0 +1,140 @@
+#include "ETag.hpp"
+#include <cstring>
+
+namespace Softadastra
+{
+    namespace
+    {
+        constexpr std::uint64_t P0 = 0xa0761d6478bd642full;
+        constexpr std::uint64_t P1 = 0xe7037ed1a0b428dbull;
+        constexpr std::uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+
+        std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+        {
+            const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+        }
+
+        // Un produit 64x64 -> 128 par bloc de 8 octets : plusieurs Go/s, largement
+        // assez pour des corps JSON recalculés à chaque requête.
+        std::uint64_t hash_bytes(const char *data, std::size_t size)
+        {
+            std::uint64_t h = mix(size ^ P0, P1);
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                std::uint64_t block;
+                std::memcpy(&block, data + i, sizeof(block));
+                h = mix(h ^ block, P1);
+            }
+            std::uint64_t tail = 0;
+            std::memcpy(&tail, data + i, size - i);
+            return mix(h ^ tail ^ P2, P0);
+        }
+
+        std::string quoted_hex(std::uint64_t value, const char *prefix = "")
+        {
+            static constexpr char DIGITS[] = "0123456789abcdef";
+            std::string tag = "\"";
+            tag += prefix;
+            for (int shift = 60; shift >= 0; shift -= 4)
+            {
+                tag.push_back(DIGITS[(value >> shift) & 0xf]);
+            }
+            tag.push_back('"');
+            return tag;
+        }
+
+        const boost::beast::string_view ENCODINGS[] = {"-gzip", "-deflate", "-zstd", "-br"};
+
+        // W/"abc-gzip" -> abc
+        boost::beast::string_view opaque_tag(boost::beast::string_view tag)
+        {
+            if (tag.starts_with("W/"))
+            {
+                tag.remove_prefix(2);
+            }
+            if (tag.size() >= 2 && tag.front() == '"' && tag.back() == '"')
+            {
+                tag = tag.substr(1, tag.size() - 2);
+            }
+            for (const boost::beast::string_view suffix : ENCODINGS)
+            {
+                if (tag.size() > suffix.size() && tag.ends_with(suffix))
+                {
+                    tag.remove_suffix(suffix.size());
+                    break;
+                }
+            }
+            return tag;
+        }
+    }
+
+    std::string etag_for(boost::beast::string_view body)
+    {
+        return quoted_hex(hash_bytes(body.data(), body.size()));
+    }
+
+    std::string etag_for_version(boost::beast::string_view version)
+    {
+        return quoted_hex(hash_bytes(version.data(), version.size()), "v");
+    }
+
+    std::string etag_for_file(std::int64_t mtime_ns, std::uint64_t size)
+    {
+        return quoted_hex(mix(static_cast<std::uint64_t>(mtime_ns) ^ P0, size ^ P1), "f");
+    }
+
+    bool etag_matches(boost::beast::string_view if_none_match, boost::beast::string_view etag)
+    {
+        if (if_none_match.empty() || etag.empty())
+        {
+            return false;
+        }
+        const boost::beast::string_view expected = opaque_tag(etag);
+        while (!if_none_match.empty())
+        {
+            const std::size_t comma = if_none_match.find(',');
+            boost::beast::string_view tag = if_none_match.substr(0, comma);
+            if_none_match = comma == boost::beast::string_view::npos ? boost::beast::string_view() : if_none_match.substr(comma + 1);
+
+            while (!tag.empty() && (tag.front() == ' ' || tag.front() == '\t'))
+            {
+                tag.remove_prefix(1);
+            }
+            while (!tag.empty() && (tag.back() == ' ' || tag.back() == '\t'))
+            {
+                tag.remove_suffix(1);
+            }
+            if (tag == "*" || (!expected.empty() && opaque_tag(tag) == expected))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void tag_encoding(http::response<http::string_body> &res, const char *encoding)
+    {
+        const auto etag = res[http::field::etag];
+        if (etag.size() < 2 || etag.back() != '"')
+        {
+            return;
+        }
+        std::string tagged(etag.data(), etag.size() - 1);
+        tagged.push_back('-');
+        tagged += encoding;
+        tagged.push_back('"');
+        res.set(http::field::etag, tagged);
+    }
+
+    void make_not_modified(http::response<http::string_body> &res)
+    {
+        res.result(http::status::not_modified);
+        res.body().clear();
+        res.erase(http::field::content_type);
+        res.erase(http::field::content_length);
+        res.erase(http::field::content_encoding);
+        res.erase(http::field::transfer_encoding);
+    }
+}
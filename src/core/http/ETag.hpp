@@ -0,0 +1,34 @@
+#ifndef ETAG_HPP
+#define ETAG_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http.hpp>
+#include <cstdint>
+#include <string>
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // ETag fort d'un corps : empreinte 64 bits non cryptographique, stable d'une
+    // instance à l'autre du serveur ("9f86d081884c7d65").
+    std::string etag_for(boost::beast::string_view body);
+    // ETag d'une version fournie par le handler (compteur, updated_at...), sans sérialiser
+    // la ressource.
+    std::string etag_for_version(boost::beast::string_view version);
+    // ETag d'un fichier, d'après sa date de modification et sa taille.
+    std::string etag_for_file(std::int64_t mtime_ns, std::uint64_t size);
+
+    // If-None-Match : "*" ou liste d'ETag, comparés faiblement (W/ ignoré). Le suffixe
+    // d'encodage ("-gzip") est ignoré des deux côtés : le contenu est le même.
+    bool etag_matches(boost::beast::string_view if_none_match, boost::beast::string_view etag);
+
+    // Corps compressé : "abc" devient "abc-gzip", une représentation par encodage.
+    void tag_encoding(http::response<http::string_body> &res, const char *encoding);
+
+    // Transforme la réponse en 304 : ni corps ni en-têtes de représentation, ETag, Vary,
+    // Cache-Control et Last-Modified conservés.
+    void make_not_modified(http::response<http::string_body> &res);
+}
+
+#endif // ETAG_HPP
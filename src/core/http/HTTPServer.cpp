@@ -3,6 +3,9 @@
 #include <memory>
 #include <thread>
 #include <vector>
+#include <algorithm>
+#include <array>
+#include <unistd.h>
 #include <system_error>
 #include <boost/system/error_code.hpp>
 #include <boost/beast.hpp>
@@ -23,11 +26,19 @@ namespace Softadastra
 
     HTTPServer::HTTPServer(Config &config)
         : config_(config),
-          io_context_(std::make_shared<net::io_context>()),
-          acceptor_(nullptr),
+          io_uring_(select_io_uring()),
+          shards_(),
+          date_(),
           router_(),
           route_configurator_(std::make_unique<RouteConfigurator>(router_)),
-          request_thread_pool_(NUMBER_OF_THREADS, 100, 0, std::chrono::milliseconds(1000)),
+          request_thread_pool_(calculate_cpu_thread_count(), calculate_cpu_thread_count(), 0, std::chrono::milliseconds(1000)),
+          blocking_thread_pool_(static_cast<size_t>(std::max(1, config.getBlockingThreads())),
+                                static_cast<size_t>(std::max(1, config.getBlockingThreads())), 0, std::chrono::milliseconds(1000)),
+          admission_(make_admission_limits()),
+          compressor_(make_compression_options(), admission_),
+          cache_(make_cache_options()),
+          tls_context_(make_tls_context()),
+          session_context_{router_, request_thread_pool_, blocking_thread_pool_, admission_, compressor_, cache_, tls_context_.get(), make_session_options()},
           io_threads_(),
           stop_requested_(false)
     {
@@ -40,42 +51,178 @@ namespace Softadastra
             }
 
             tcp::endpoint endpoint(boost::asio::ip::address_v4::any(), static_cast<unsigned short>(newPort));
-            acceptor_ = std::make_unique<tcp::acceptor>(*io_context_);
 
-            boost::system::error_code ec;
-            acceptor_->open(endpoint.protocol(), ec);
-            if (ec)
+            if (is_sharded())
             {
-                spdlog::error("Failed to open acceptor socket: {} (Error code: {})", ec.message(), ec.value());
-                throw std::system_error(ec, "Could not open the acceptor socket");
+                std::size_t shard_count = calculate_shard_count();
+                shards_.resize(shard_count);
+                for (auto &shard : shards_)
+                {
+                    shard.io_context = std::make_unique<net::io_context>(1);
+                    shard.acceptor = open_acceptor(*shard.io_context, endpoint, true);
+                    shard.thread_count = 1;
+                    init_shard(shard);
+                }
             }
-
-            acceptor_->set_option(boost::asio::socket_base::reuse_address(true), ec);
-            if (ec)
+            else
             {
-                spdlog::error("Failed to set socket option: {} (Error code: {})", ec.message(), ec.value());
-                throw std::system_error(ec, "Could not set socket option");
+                shards_.resize(1);
+                IoShard &shard = shards_.front();
+                shard.io_context = std::make_unique<net::io_context>();
+                shard.acceptor = open_acceptor(*shard.io_context, endpoint, false);
+                shard.thread_count = static_cast<std::size_t>(calculate_io_thread_count());
+                init_shard(shard);
             }
+            date_ = std::make_unique<HttpDate>(*shards_.front().io_context);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("Error initializing server: {}", e.what());
+            throw;
+        }
+    }
 
-            acceptor_->bind(endpoint, ec);
-            if (ec)
-            {
-                spdlog::error("Failed to bind to the server port: {} (Error code: {})", ec.message(), ec.value());
-                throw std::system_error(ec, "Could not bind to the server port");
-            }
+    SessionOptions HTTPServer::make_session_options() const
+    {
+        SessionOptions options;
+        options.read_timeout = std::chrono::seconds(config_.getReadTimeout());
+        options.keep_alive_timeout = std::chrono::seconds(config_.getKeepAliveTimeout());
+        options.write_timeout = std::chrono::seconds(config_.getWriteTimeout());
+        options.max_keep_alive_requests = static_cast<std::size_t>(std::max(1, config_.getMaxKeepAliveRequests()));
+        return options;
+    }
+
+    AdmissionController::Limits HTTPServer::make_admission_limits() const
+    {
+        AdmissionController::Limits limits;
+        limits.max_connections = static_cast<std::size_t>(std::max(0, config_.getMaxConnections()));
+        limits.max_queued_requests = static_cast<std::size_t>(std::max(0, config_.getMaxQueuedRequests()));
+        limits.action = config_.getOverloadAction() == "pause" ? AdmissionController::OverloadAction::Pause
+                                                               : AdmissionController::OverloadAction::Reject;
+        limits.retry_after = std::chrono::seconds(std::max(0, config_.getRetryAfter()));
+        return limits;
+    }
+
+    ResponseCompressor::Options HTTPServer::make_compression_options() const
+    {
+        ResponseCompressor::Options options;
+        options.enabled = config_.getCompressionEnabled();
+        options.min_size = static_cast<std::size_t>(std::max(0, config_.getCompressionMinSize()));
+        options.level = std::clamp(config_.getCompressionLevel(), 1, 9);
+        options.min_level = std::clamp(config_.getCompressionMinLevel(), 1, options.level);
+        options.saturation_queue = static_cast<std::size_t>(std::max(0, config_.getCompressionSaturationQueue()));
+        options.zstd = config_.getCompressionZstd();
+        return options;
+    }
+
+    ResponseCache::Options HTTPServer::make_cache_options() const
+    {
+        ResponseCache::Options options;
+        options.enabled = config_.getCacheEnabled();
+        options.max_entries = static_cast<std::size_t>(std::max(1, config_.getCacheMaxEntries()));
+        options.max_body_size = static_cast<std::size_t>(std::max(0, config_.getCacheMaxBodySize()));
+        for (const auto &[route, route_config] : config_.getCacheRoutes())
+        {
+            ResponseCache::Policy policy;
+            policy.ttl = std::chrono::milliseconds(route_config.ttl_ms);
+            policy.stale = std::chrono::milliseconds(route_config.stale_ms);
+            policy.vary = route_config.vary;
+            options.routes.emplace(route, std::move(policy));
+        }
+        return options;
+    }
+
+    AsyncLog::Options HTTPServer::make_log_options() const
+    {
+        AsyncLog::Options options;
+        options.level = spdlog::level::from_str(config_.getLogLevel());
+        options.queue_size = static_cast<std::size_t>(config_.getLogQueueSize());
+        options.access_sample_rate = config_.getLogAccessSampleRate();
+        return options;
+    }
+
+    std::unique_ptr<TlsContext> HTTPServer::make_tls_context() const
+    {
+        if (!config_.getTlsEnabled())
+        {
+            return nullptr;
+        }
+
+        TlsContext::Options options;
+        options.certificate_file = config_.getTlsCertificateFile();
+        options.private_key_file = config_.getTlsPrivateKeyFile();
+        options.session_cache_size = std::max(0, config_.getTlsSessionCacheSize());
+        options.session_timeout = std::chrono::seconds(std::max(1, config_.getTlsSessionTimeout()));
+        options.ticket_key_rotation = std::chrono::seconds(std::max(1, config_.getTlsTicketKeyRotation()));
+        options.ktls = config_.getTlsKtls();
+        return std::make_unique<TlsContext>(options);
+    }
+
+    void HTTPServer::init_shard(IoShard &shard)
+    {
+        shard.timers = std::make_unique<TimingWheel>(*shard.io_context);
+        shard.accept_timer = std::make_unique<net::steady_timer>(*shard.io_context);
+        if (io_uring_)
+        {
+            shard.uring = std::make_unique<UringLoop>(*shard.io_context);
+            // Hérité par les sockets acceptées : pas de setsockopt par connexion.
+            shard.acceptor->set_option(tcp::no_delay(true));
+        }
+        shard.sessions = std::make_unique<SessionPool>(
+            *shard.io_context, session_context_, *shard.timers, shard.uring.get(),
+            static_cast<std::size_t>(std::max(0, config_.getSessionPoolMaxSessions())),
+            static_cast<std::size_t>(std::max(0, config_.getSessionPoolMaxBytes())));
+    }
 
-            acceptor_->listen(boost::asio::socket_base::max_connections, ec);
+    std::unique_ptr<tcp::acceptor> HTTPServer::open_acceptor(net::io_context &io_context, const tcp::endpoint &endpoint, bool reuse_port)
+    {
+        auto acceptor = std::make_unique<tcp::acceptor>(io_context);
+
+        boost::system::error_code ec;
+        acceptor->open(endpoint.protocol(), ec);
+        if (ec)
+        {
+            spdlog::error("Failed to open acceptor socket: {} (Error code: {})", ec.message(), ec.value());
+            throw std::system_error(ec, "Could not open the acceptor socket");
+        }
+
+        acceptor->set_option(boost::asio::socket_base::reuse_address(true), ec);
+        if (ec)
+        {
+            spdlog::error("Failed to set socket option: {} (Error code: {})", ec.message(), ec.value());
+            throw std::system_error(ec, "Could not set socket option");
+        }
+
+        if (reuse_port)
+        {
+#ifdef SO_REUSEPORT
+            using reuse_port_option = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+            acceptor->set_option(reuse_port_option(true), ec);
             if (ec)
             {
-                spdlog::error("Failed to listen on the server port: {} (Error code: {})", ec.message(), ec.value());
-                throw std::system_error(ec, "Could not listen on the server port");
+                spdlog::error("Failed to set SO_REUSEPORT: {} (Error code: {})", ec.message(), ec.value());
+                throw std::system_error(ec, "Could not set SO_REUSEPORT");
             }
+#else
+            throw std::runtime_error("Sharded io_model requires SO_REUSEPORT, which this platform does not provide");
+#endif
         }
-        catch (const std::exception &e)
+
+        acceptor->bind(endpoint, ec);
+        if (ec)
         {
-            spdlog::error("Error initializing server: {}", e.what());
-            throw;
+            spdlog::error("Failed to bind to the server port: {} (Error code: {})", ec.message(), ec.value());
+            throw std::system_error(ec, "Could not bind to the server port");
         }
+
+        acceptor->listen(boost::asio::socket_base::max_connections, ec);
+        if (ec)
+        {
+            spdlog::error("Failed to listen on the server port: {} (Error code: {})", ec.message(), ec.value());
+            throw std::system_error(ec, "Could not listen on the server port");
+        }
+
+        return acceptor;
     }
 
     HTTPServer::~HTTPServer() {}
@@ -84,30 +231,47 @@ namespace Softadastra
     {
         try
         {
+            AsyncLog::instance().start(make_log_options());
             route_configurator_->configure_routes();
+            register_status_route();
+            route_configurator_->configure_middleware();
+            router_.seal();
 
-            spdlog::info("Softadastra/master server is running at http://127.0.0.1:{} using {} threads", config_.getServerPort(), NUMBER_OF_THREADS);
+            spdlog::info("Softadastra/master server is running at {}://127.0.0.1:{} using {} threads",
+                         tls_context_ ? "https" : "http", config_.getServerPort(), calculate_cpu_thread_count());
             spdlog::info("Waiting for incoming connections...");
 
             start_accept();
 
-            int num_io_threads = calculate_io_thread_count();
-            spdlog::info("Starting {} io_context threads", num_io_threads);
+            if (is_sharded())
+            {
+                spdlog::info("Starting {} io_context shards (SO_REUSEPORT, one thread per shard, {} backend)",
+                             shards_.size(), io_uring_ ? "io_uring" : "epoll");
+            }
+            else
+            {
+                spdlog::info("Starting {} io_context threads", shards_.front().thread_count);
+            }
 
-            for (std::size_t i = 0; i < num_io_threads; ++i)
+            std::size_t thread_index = 0;
+            for (auto &shard : shards_)
             {
-                io_threads_.emplace_back([this, i]()
-                                         {
-                    try
-                    {
-                        set_affinity(i); 
-                        io_context_->run();
-                    }
-                    catch (const std::exception &e)
-                    {
-                        spdlog::error("Error in io_context (thread {}): {}", i, e.what());
-                    }
-                    spdlog::info("Thread {} finished.", i); });
+                for (std::size_t j = 0; j < shard.thread_count; ++j, ++thread_index)
+                {
+                    net::io_context *io_context = shard.io_context.get();
+                    io_threads_.emplace_back([io_context, i = thread_index]()
+                                             {
+                        try
+                        {
+                            set_affinity(static_cast<int>(i));
+                            io_context->run();
+                        }
+                        catch (const std::exception &e)
+                        {
+                            spdlog::error("Error in io_context (thread {}): {}", i, e.what());
+                        }
+                        spdlog::info("Thread {} finished.", i); });
+                }
             }
 
             for (auto &t : io_threads_)
@@ -121,6 +285,7 @@ namespace Softadastra
         {
             spdlog::error("Error in HTTPServer::run(): {}", e.what());
         }
+        AsyncLog::instance().stop();
     }
 
     int HTTPServer::calculate_io_thread_count()
@@ -128,65 +293,368 @@ namespace Softadastra
         return std::max(1, static_cast<int>(std::thread::hardware_concurrency() / 2));
     }
 
-    void HTTPServer::start_accept()
+    bool HTTPServer::is_sharded() const
     {
-        auto socket = std::make_shared<tcp::socket>(*io_context_);
+        return config_.getIoModel() == "sharded";
+    }
 
-        try
+    bool HTTPServer::select_io_uring() const
+    {
+        if (config_.getIoBackend() != "io_uring")
         {
-            acceptor_->async_accept(*socket, [this, socket](boost::system::error_code ec)
-                                    {
-                                        if (!ec)
-                                        {
-                                            request_thread_pool_.enqueue(1, [this, socket]() {
-                                                try {
-                                                    handle_client(socket, router_);
-                                                } catch (const std::exception &e) {
-                                                    spdlog::error("Error handling client: {}", e.what());
-                                                    close_socket(socket);
-                                                }
-                                            });
-                                        }
-                                        else
-                                        {
-                                            spdlog::error("Error accepting connection from client: {} (Error code: {})", ec.message(), ec.value());
-                                        }
-
-                                        start_accept(); });
+            return false;
         }
-        catch (const std::exception &e)
+        if (config_.getTlsEnabled())
         {
-            spdlog::error("Exception during async_accept: {}", e.what());
-            acceptor_->close();
+            // OpenSSL lit et écrit lui-même sur la socket, hors de l'anneau.
+            spdlog::warn("io_backend \"io_uring\" does not support TLS, falling back to epoll");
+            return false;
+        }
+        if (!is_sharded())
+        {
+            // Un anneau n'est soumis que depuis un seul thread : un par shard.
+            spdlog::warn("io_backend \"io_uring\" requires io_model \"sharded\", falling back to epoll");
+            return false;
+        }
+        if (!UringLoop::supported())
+        {
+            spdlog::warn("io_uring is not available on this kernel, falling back to epoll");
+            return false;
+        }
+        return true;
+    }
+
+    std::size_t HTTPServer::calculate_shard_count() const
+    {
+        if (config_.getIoThreads() > 0)
+        {
+            return static_cast<std::size_t>(config_.getIoThreads());
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::size_t HTTPServer::calculate_cpu_thread_count() const
+    {
+        // Taille fixe : un handler CpuPool occupe un cœur, des threads en plus ne feraient
+        // que se le disputer. Au-delà, les requêtes attendent dans la file, bornée par
+        // l'admission (max_queued_requests, puis 503).
+        if (config_.getCpuThreads() > 0)
+        {
+            return static_cast<std::size_t>(config_.getCpuThreads());
         }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    SessionPool::Stats HTTPServer::session_pool_stats() const
+    {
+        SessionPool::Stats total{0, 0, 0, 0, 0};
+        for (const auto &shard : shards_)
+        {
+            SessionPool::Stats stats = shard.sessions->stats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.discarded += stats.discarded;
+            total.retained_sessions += stats.retained_sessions;
+            total.retained_bytes += stats.retained_bytes;
+        }
+        return total;
+    }
+
+    AdmissionController::Stats HTTPServer::admission_stats() const
+    {
+        return admission_.stats();
     }
 
-    void HTTPServer::close_socket(std::shared_ptr<tcp::socket> socket)
+    UringLoop::Stats HTTPServer::io_uring_stats() const
     {
+        UringLoop::Stats total{0, 0, 0, 0};
+        for (const auto &shard : shards_)
+        {
+            if (!shard.uring)
+            {
+                continue;
+            }
+            UringLoop::Stats stats = shard.uring->stats();
+            total.submit_calls += stats.submit_calls;
+            total.submitted += stats.submitted;
+            total.completions += stats.completions;
+            total.buffer_exhausted += stats.buffer_exhausted;
+        }
+        return total;
+    }
+
+    void HTTPServer::register_status_route()
+    {
+        const std::string &endpoint = config_.getStatusEndpoint();
+        if (endpoint.empty())
+        {
+            return;
+        }
+
+        router_.add_route(http::verb::get, endpoint,
+                          SimpleRequestHandler(
+                              [this](const http::request<http::string_body> &,
+                                     http::response<http::string_body> &res)
+                              {
+                                  AdmissionController::Stats admission = admission_stats();
+                                  SessionPool::Stats sessions = session_pool_stats();
+                                  UringLoop::Stats uring = io_uring_stats();
+                                  AsyncLog::Stats logging = AsyncLog::instance().stats();
+                                  json tls = nullptr;
+                                  if (tls_context_)
+                                  {
+                                      TlsContext::Stats stats = tls_context_->stats();
+                                      const std::uint64_t handshakes = stats.full_handshakes + stats.resumed_handshakes;
+                                      tls = {{"full_handshakes", stats.full_handshakes},
+                                             {"resumed_handshakes", stats.resumed_handshakes},
+                                             {"failed_handshakes", stats.failed_handshakes},
+                                             {"resumption_ratio", handshakes ? static_cast<double>(stats.resumed_handshakes) / handshakes : 0.0},
+                                             {"avg_handshake_us", handshakes ? stats.handshake_time_us / handshakes : 0},
+                                             {"ticket_key_rotations", stats.ticket_key_rotations},
+                                             {"tickets_renewed", stats.tickets_renewed},
+                                             {"session_cache_hits", stats.session_cache_hits},
+                                             {"session_cache_misses", stats.session_cache_misses},
+                                             {"session_cache_size", stats.session_cache_size},
+                                             {"ktls_connections", stats.ktls_connections},
+                                             {"ktls_fallbacks", stats.ktls_fallbacks}};
+                                  }
+                                  json files = json::array();
+                                  for (const auto &mount : router_.static_mounts())
+                                  {
+                                      StaticFiles::Stats stats = mount->stats();
+                                      files.push_back({{"prefix", mount->prefix()},
+                                                       {"hits", stats.hits},
+                                                       {"misses", stats.misses},
+                                                       {"rejected", stats.rejected},
+                                                       {"precompressed", stats.precompressed},
+                                                       {"open_files", stats.open_files}});
+                                  }
+                                  json compression = {{"level", compressor_.current_level()}, {"routes", json::object()}};
+                                  for (const auto &[route, stats] : compressor_.stats())
+                                  {
+                                      compression["routes"][route] = {{"responses", stats.responses},
+                                                                      {"bytes_in", stats.bytes_in},
+                                                                      {"bytes_out", stats.bytes_out},
+                                                                      {"bytes_saved", stats.bytes_in - stats.bytes_out},
+                                                                      {"cpu_us", stats.cpu_us}};
+                                  }
+                                  json middleware = json::object();
+                                  for (const auto &[name, stats] : router_.middleware_stats())
+                                  {
+                                      middleware[name] = {{"calls", stats.calls},
+                                                          {"stopped", stats.stopped},
+                                                          {"before_us", stats.before_ns / 1000},
+                                                          {"after_us", stats.after_ns / 1000}};
+                                  }
+                                  ResponseCache::Stats cache = cache_.stats();
+                                  Response::json_response(res, json{
+                                                                   {"cache", {{"hits", cache.hits},
+                                                                              {"stale_hits", cache.stale_hits},
+                                                                              {"misses", cache.misses},
+                                                                              {"waits", cache.waits},
+                                                                              {"uncacheable", cache.uncacheable},
+                                                                              {"evictions", cache.evictions},
+                                                                              {"entries", cache.entries}}},
+                                                                   {"compression", compression},
+                                                                   {"middleware", middleware},
+                                                               {"logging", {{"written", logging.written},
+                                                                            {"dropped", logging.dropped},
+                                                                            {"truncated", logging.truncated}}},
+                                                                   {"tls", tls},
+                                                                   {"static", files},
+                                                                   {"io", {{"backend", io_uring_ ? "io_uring" : "epoll"},
+                                                                           {"submit_calls", uring.submit_calls},
+                                                                           {"submitted", uring.submitted},
+                                                                           {"completions", uring.completions},
+                                                                           {"buffer_exhausted", uring.buffer_exhausted}}},
+                                                                   {"admission", {{"admitted_connections", admission.admitted_connections},
+                                                                                  {"rejected_connections", admission.rejected_connections},
+                                                                                  {"admitted_requests", admission.admitted_requests},
+                                                                                  {"rejected_requests", admission.rejected_requests},
+                                                                                  {"accept_pauses", admission.accept_pauses},
+                                                                                  {"active_connections", admission.active_connections},
+                                                                                  {"queued_requests", admission.queued_requests}}},
+                                                                   {"session_pool", {{"hits", sessions.hits},
+                                                                                     {"misses", sessions.misses},
+                                                                                     {"discarded", sessions.discarded},
+                                                                                     {"retained_sessions", sessions.retained_sessions},
+                                                                                     {"retained_bytes", sessions.retained_bytes}}}});
+                              }));
+    }
+
+    void HTTPServer::reject_connection(tcp::socket &socket)
+    {
+        // Surcharge : la réponse 503 pré-formatée tient dans le tampon d'émission, un
+        // write_some non bloquant suffit ; aucune session n'est créée, aucun pool sollicité.
         boost::system::error_code ec;
-        socket->shutdown(tcp::socket::shutdown_both, ec);
-        if (ec && ec != boost::system::error_code{})
+        if (tls_context_)
         {
-            spdlog::error("Failed to shutdown socket: {} (Error code: {})", ec.message(), ec.value());
+            // Pas de 503 en clair sur une connexion TLS : un handshake coûterait plus cher.
+            socket.close(ec);
+            return;
         }
-        socket->close(ec);
-        if (ec && ec != boost::system::error_code{})
+        socket.non_blocking(true, ec);
+
+        std::array<char, 1024> discard;
+        socket.read_some(net::buffer(discard), ec); // requête déjà arrivée : évite un RST à la fermeture
+
+        socket.write_some(net::buffer(admission_.overload_response()), ec);
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+        socket.close(ec);
+    }
+
+    void HTTPServer::start_accept()
+    {
+        date_->start();
+        for (auto &shard : shards_)
         {
-            spdlog::error("Failed to close socket: {} (Error code: {})", ec.message(), ec.value());
+            shard.timers->start();
+            if (shard.uring)
+            {
+                shard.uring->start();
+                start_native_accept(shard);
+            }
+            else
+            {
+                start_accept(shard);
+            }
         }
     }
 
-    void HTTPServer::handle_client(std::shared_ptr<tcp::socket> socket_ptr, Router &router)
+    void HTTPServer::start_native_accept(IoShard &shard)
+    {
+        // Accept multishot : une seule SQE produit une complétion par connexion.
+        shard.uring->listen(shard.acceptor->native_handle(), [this, &shard](int fd)
+                            { on_native_accept(shard, fd); });
+    }
+
+    void HTTPServer::on_native_accept(IoShard &shard, int fd)
     {
+        if (!admission_.try_admit_connection())
+        {
+            boost::system::error_code ec;
+            tcp::socket socket(*shard.io_context);
+            socket.assign(tcp::v4(), fd, ec);
+            if (ec)
+            {
+                ::close(fd);
+            }
+            else
+            {
+                reject_connection(socket);
+            }
+        }
+        else
+        {
+            try
+            {
+                shard.sessions->acquire(fd)->run();
+            }
+            catch (const std::exception &e)
+            {
+                spdlog::error("Error handling client: {}", e.what());
+            }
+        }
+
+        if (admission_.limits().action == AdmissionController::OverloadAction::Pause &&
+            admission_.connections_saturated() && !shard.accept_paused)
+        {
+            // L'accept multishot est annulé ; les connexions attendent dans la file du noyau.
+            shard.accept_paused = true;
+            admission_.record_accept_pause();
+            spdlog::warn("Connection limit reached, pausing accept()");
+            shard.uring->pause_accept();
+            wait_for_capacity(shard);
+        }
+    }
+
+    void HTTPServer::wait_for_capacity(IoShard &shard)
+    {
+        shard.accept_timer->expires_after(ACCEPT_RETRY_DELAY);
+        shard.accept_timer->async_wait([this, &shard](boost::system::error_code ec)
+                                       {
+                                           if (ec)
+                                           {
+                                               return;
+                                           }
+                                           if (admission_.connections_saturated())
+                                           {
+                                               wait_for_capacity(shard);
+                                               return;
+                                           }
+                                           shard.accept_paused = false;
+                                           shard.uring->resume_accept(); });
+    }
+
+    void HTTPServer::start_accept(IoShard &shard)
+    {
+        // En mode sharded la socket reste sur l'io_context (mono-thread) du shard ; en mode
+        // shared elle reçoit un strand, car plusieurs threads exécutent le même io_context.
+        // La session démarre directement sur ce thread : seuls les handlers déclarés
+        // CpuPool/Blocking passent par un pool.
+        if (admission_.limits().action == AdmissionController::OverloadAction::Pause && admission_.connections_saturated())
+        {
+            // Les connexions restent dans la file du noyau jusqu'à la reprise.
+            if (!shard.accept_paused)
+            {
+                shard.accept_paused = true;
+                admission_.record_accept_pause();
+                spdlog::warn("Connection limit reached, pausing accept()");
+            }
+            shard.accept_timer->expires_after(ACCEPT_RETRY_DELAY);
+            shard.accept_timer->async_wait([this, &shard](boost::system::error_code ec)
+                                           {
+                                               if (!ec)
+                                               {
+                                                   start_accept(shard);
+                                               } });
+            return;
+        }
+        shard.accept_paused = false;
+
+        auto on_accept = [this, &shard](boost::system::error_code ec, tcp::socket socket)
+        {
+            if (!ec && !admission_.try_admit_connection())
+            {
+                reject_connection(socket);
+            }
+            else if (!ec)
+            {
+                try
+                {
+                    shard.sessions->acquire(std::move(socket))->run();
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Error handling client: {}", e.what());
+                }
+            }
+            else
+            {
+                spdlog::error("Error accepting connection from client: {} (Error code: {})", ec.message(), ec.value());
+            }
+
+            if (shard.acceptor->is_open())
+            {
+                start_accept(shard);
+            }
+        };
+
         try
         {
-            auto session = std::make_shared<Session>(std::move(*socket_ptr), router);
-            session->run();
+            if (is_sharded())
+            {
+                shard.acceptor->async_accept(shard.io_context->get_executor(), std::move(on_accept));
+            }
+            else
+            {
+                shard.acceptor->async_accept(net::make_strand(*shard.io_context), std::move(on_accept));
+            }
         }
         catch (const std::exception &e)
         {
-            spdlog::error("Error in client session for client {}: {}", socket_ptr->remote_endpoint().address().to_string(), e.what());
-            socket_ptr->close();
+            spdlog::error("Exception during async_accept: {}", e.what());
+            shard.acceptor->close();
         }
     }
 
@@ -17,14 +17,21 @@
 #include <spdlog/spdlog.h>
 
 #include "SimpleRequestHandler.hpp"
-#include "IRequestHandler.hpp"
 #include "DynamicRequestHandler.hpp"
 #include "config/Config.hpp"
 #include "routing/Router.hpp"
 #include "session/Session.hpp"
+#include "session/SessionPool.hpp"
+#include "uring/UringLoop.hpp"
+#include "tls/TlsContext.hpp"
 #include "Response.hpp"
 #include "config/RouteConfigurator.hpp"
 #include "ThreadPool.hpp"
+#include "AdmissionController.hpp"
+#include "Compression.hpp"
+#include "ResponseCache.hpp"
+#include "HttpDate.hpp"
+#include "logging/AsyncLog.hpp"
 
 namespace Softadastra
 {
@@ -36,7 +43,23 @@ namespace Softadastra
     using tcp = net::ip::tcp;
     using json = nlohmann::json;
 
-    constexpr size_t NUMBER_OF_THREADS = 8;
+    constexpr std::chrono::milliseconds ACCEPT_RETRY_DELAY{20};
+
+    // Un io_context et son acceptor. En mode "shared" il n'existe qu'un seul shard,
+    // exécuté par plusieurs threads ; en mode "sharded" chaque cœur possède le sien
+    // (acceptor SO_REUSEPORT) et une connexion ne quitte jamais le thread qui l'a acceptée.
+    struct IoShard
+    {
+        std::unique_ptr<net::io_context> io_context;
+        std::unique_ptr<tcp::acceptor> acceptor;
+        std::unique_ptr<TimingWheel> timers; // échéances read/idle/write des sessions du shard
+        std::unique_ptr<UringLoop> uring;    // backend "io_uring" uniquement
+        std::unique_ptr<SessionPool> sessions; // détruit avant timers : les sessions s'y désinscrivent
+        std::unique_ptr<net::steady_timer> accept_timer; // reprise de accept() en mode "pause"
+        bool accept_paused = false;
+        std::size_t thread_count = 1;
+    };
+
     class HTTPServer
     {
     public:
@@ -45,16 +68,42 @@ namespace Softadastra
         void run();
         void start_accept();
         int calculate_io_thread_count();
+        SessionPool::Stats session_pool_stats() const;
+        AdmissionController::Stats admission_stats() const;
+        UringLoop::Stats io_uring_stats() const;
 
     private:
-        void handle_client(std::shared_ptr<tcp::socket> socket_ptr, Router &router);
-        void close_socket(std::shared_ptr<tcp::socket> socket);
+        bool is_sharded() const;
+        bool select_io_uring() const;
+        std::size_t calculate_shard_count() const;
+        std::size_t calculate_cpu_thread_count() const;
+        SessionOptions make_session_options() const;
+        void init_shard(IoShard &shard);
+        AdmissionController::Limits make_admission_limits() const;
+        ResponseCompressor::Options make_compression_options() const;
+        ResponseCache::Options make_cache_options() const;
+        AsyncLog::Options make_log_options() const;
+        std::unique_ptr<TlsContext> make_tls_context() const;
+        void register_status_route();
+        void reject_connection(tcp::socket &socket);
+        std::unique_ptr<tcp::acceptor> open_acceptor(net::io_context &io_context, const tcp::endpoint &endpoint, bool reuse_port);
+        void start_accept(IoShard &shard);
+        void start_native_accept(IoShard &shard);
+        void on_native_accept(IoShard &shard, int fd);
+        void wait_for_capacity(IoShard &shard);
         Config &config_;
-        std::shared_ptr<net::io_context> io_context_;
-        std::unique_ptr<tcp::acceptor> acceptor_;
+        bool io_uring_;
+        std::vector<IoShard> shards_;
+        std::unique_ptr<HttpDate> date_; // sur le premier shard ; détruit avant les io_context
         Router router_;
         std::unique_ptr<RouteConfigurator> route_configurator_;
         Softadastra::ThreadPool request_thread_pool_;
+        Softadastra::ThreadPool blocking_thread_pool_;
+        AdmissionController admission_;
+        ResponseCompressor compressor_;
+        ResponseCache cache_;
+        std::unique_ptr<TlsContext> tls_context_;
+        SessionContext session_context_;
         std::vector<std::thread> io_threads_;
         std::atomic<bool> stop_requested_;
     };
@@ -0,0 +1,137 @@
+#include "HttpDate.hpp"
+#include <chrono>
+#include <cstring>
+#include <time.h>
+
+namespace Softadastra
+{
+    namespace
+    {
+        std::size_t format_date(std::time_t time, char *buffer, std::size_t size)
+        {
+            std::tm tm{};
+            gmtime_r(&time, &tm);
+            return std::strftime(buffer, size, "%a, %d %b %Y %H:%M:%S GMT", &tm);
+        }
+    }
+
+    HttpDate::Slot HttpDate::slots_[HttpDate::SLOTS] = {};
+    std::atomic<std::size_t> HttpDate::current_{0};
+    std::atomic<std::time_t> HttpDate::second_{0};
+    std::atomic<int> HttpDate::clocks_{0};
+    std::atomic_flag HttpDate::writing_ = ATOMIC_FLAG_INIT;
+
+    HttpDate::HttpDate(net::io_context &io_context)
+        : timer_(io_context),
+          running_(false)
+    {
+    }
+
+    HttpDate::~HttpDate()
+    {
+        stop();
+    }
+
+    void HttpDate::start()
+    {
+        if (running_)
+        {
+            return;
+        }
+        running_ = true;
+        clocks_.fetch_add(1, std::memory_order_relaxed);
+        refresh(std::time(nullptr));
+        schedule();
+    }
+
+    void HttpDate::stop()
+    {
+        if (!running_)
+        {
+            return;
+        }
+        running_ = false;
+        clocks_.fetch_sub(1, std::memory_order_relaxed);
+        timer_.cancel();
+    }
+
+    void HttpDate::schedule()
+    {
+        // Réveil juste après le changement de seconde de l'horloge murale : la date
+        // publiée ne retarde au plus que de la latence du timer.
+        const auto now = std::chrono::system_clock::now();
+        const auto into_second = now.time_since_epoch() % std::chrono::seconds(1);
+        timer_.expires_after(std::chrono::seconds(1) - into_second + std::chrono::milliseconds(1));
+        timer_.async_wait([this](const boost::system::error_code &ec)
+                          {
+            if (ec || !running_)
+            {
+                return;
+            }
+            refresh(std::time(nullptr));
+            schedule(); });
+    }
+
+    void HttpDate::refresh(std::time_t time)
+    {
+        // Un seul rédacteur à la fois ; les autres gardent la date déjà publiée.
+        if (writing_.test_and_set(std::memory_order_acquire))
+        {
+            return;
+        }
+        if (second_.load(std::memory_order_relaxed) != time)
+        {
+            const std::size_t next = current_.load(std::memory_order_relaxed) + 1;
+            Slot &slot = slots_[next & (SLOTS - 1)];
+            format_date(time, slot.text, sizeof(slot.text));
+            second_.store(time, std::memory_order_relaxed);
+            current_.store(next, std::memory_order_release);
+        }
+        writing_.clear(std::memory_order_release);
+    }
+
+    boost::beast::string_view HttpDate::now()
+    {
+        if (clocks_.load(std::memory_order_relaxed) == 0 || current_.load(std::memory_order_relaxed) == 0)
+        {
+            const std::time_t time = std::time(nullptr);
+            if (time != second_.load(std::memory_order_relaxed))
+            {
+                refresh(time);
+            }
+        }
+        // Premier appel concurrent pendant que le rédacteur formate encore : calcul local.
+        const std::size_t current = current_.load(std::memory_order_acquire);
+        if (current == 0)
+        {
+            thread_local char buffer[32];
+            return boost::beast::string_view(buffer, format_date(std::time(nullptr), buffer, sizeof(buffer)));
+        }
+        return boost::beast::string_view(slots_[current & (SLOTS - 1)].text, LENGTH);
+    }
+
+    std::string HttpDate::format(std::time_t time)
+    {
+        char buffer[32];
+        return std::string(buffer, format_date(time, buffer, sizeof(buffer)));
+    }
+
+    std::time_t HttpDate::parse(boost::beast::string_view text)
+    {
+        char buffer[64];
+        if (text.size() >= sizeof(buffer))
+        {
+            return -1;
+        }
+        std::memcpy(buffer, text.data(), text.size());
+        buffer[text.size()] = '\0';
+
+        std::tm tm{};
+        const char *end = ::strptime(buffer, "%a, %d %b %Y %H:%M:%S GMT", &tm);
+        if (!end || *end != '\0')
+        {
+            return -1;
+        }
+        return ::timegm(&tm);
+    }
+}
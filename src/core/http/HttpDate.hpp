@@ -0,0 +1,61 @@
+#ifndef HTTPDATE_HPP
+#define HTTPDATE_HPP
+
+#include <boost/asio.hpp>
+#include <boost/beast/core/string.hpp>
+#include <atomic>
+#include <ctime>
+#include <string>
+
+namespace Softadastra
+{
+    namespace net = boost::asio;
+
+    // En-tête Date (IMF-fixdate) de la seconde courante, formaté une fois par seconde et
+    // partagé par toutes les réponses. La lecture est sans verrou ni allocation : un
+    // lecteur prend le dernier emplacement publié, que l'horloge ne réécrira pas avant
+    // plusieurs secondes.
+    class HttpDate
+    {
+    public:
+        static constexpr std::size_t LENGTH = 29; // "Sun, 06 Nov 1994 08:49:37 GMT"
+
+        // Rafraîchit le cache à chaque changement de seconde, sur l'io_context donné.
+        explicit HttpDate(net::io_context &io_context);
+        ~HttpDate();
+        HttpDate(const HttpDate &) = delete;
+        HttpDate &operator=(const HttpDate &) = delete;
+
+        void start();
+        void stop();
+
+        // Date courante ; sans horloge démarrée (outils, tests), le cache se met à jour
+        // à la lecture quand la seconde a changé.
+        static boost::beast::string_view now();
+        static std::string format(std::time_t time);
+        // Date reçue (If-Modified-Since), au format IMF-fixdate ; -1 si illisible.
+        static std::time_t parse(boost::beast::string_view text);
+
+    private:
+        static constexpr std::size_t SLOTS = 8; // puissance de 2
+
+        struct Slot
+        {
+            char text[32];
+        };
+
+        static void refresh(std::time_t time);
+        void schedule();
+
+        net::steady_timer timer_;
+        bool running_;
+
+        static Slot slots_[SLOTS];
+        static std::atomic<std::size_t> current_;
+        static std::atomic<std::time_t> second_;
+        static std::atomic<int> clocks_; // horloges démarrées
+        static std::atomic_flag writing_;
+    };
+}
+
+#endif // HTTPDATE_HPP
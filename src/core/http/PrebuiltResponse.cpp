@@ -0,0 +1,39 @@
+#include "PrebuiltResponse.hpp"
+#include "HttpDate.hpp"
+#include "ETag.hpp"
+#include <sstream>
+
+namespace Softadastra
+{
+    PrebuiltResponse::PrebuiltResponse(http::response<http::string_body> response)
+        : response_(std::move(response)),
+          head_()
+    {
+        response_.version(11);
+        response_.erase(http::field::date);
+        response_.erase(http::field::connection);
+        response_.erase(http::field::keep_alive);
+        response_.prepare_payload();
+        if (response_.result() == http::status::ok && response_.find(http::field::etag) == response_.end())
+        {
+            response_.set(http::field::etag, etag_for(response_.body()));
+        }
+
+        // Sérialisation par beast une fois pour toutes ; la ligne vide finale est retirée
+        // pour laisser la place aux en-têtes variables.
+        std::ostringstream out;
+        out << response_.base();
+        head_ = out.str();
+        head_.resize(head_.size() - 2);
+    }
+
+    std::size_t PrebuiltResponse::append_tail(std::string &out, bool keep_alive)
+    {
+        const std::size_t start = out.size();
+        const auto date = HttpDate::now();
+        out.append("Date: ");
+        out.append(date.data(), date.size());
+        out.append(keep_alive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n");
+        return out.size() - start;
+    }
+}
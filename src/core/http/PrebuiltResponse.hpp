@@ -0,0 +1,35 @@
+#ifndef PREBUILTRESPONSE_HPP
+#define PREBUILTRESPONSE_HPP
+
+#include <boost/beast/http.hpp>
+#include <string>
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Réponse constante sérialisée une seule fois au démarrage : ligne de statut, en-têtes
+    // et corps restent dans des tampons immuables partagés par toutes les connexions, et
+    // seuls Date et Connection sont écrits à chaque envoi.
+    class PrebuiltResponse
+    {
+    public:
+        explicit PrebuiltResponse(http::response<http::string_body> response);
+
+        // Ligne de statut et en-têtes fixes, chacun terminé par "\r\n".
+        const std::string &head() const { return head_; }
+        const std::string &body() const { return response_.body(); }
+        // Réponse d'origine (sans Date ni Connection), pour les chemins qui ne
+        // passent pas par la session (HTTP/1.0, appel direct du Router).
+        const http::response<http::string_body> &response() const { return response_; }
+
+        // Ajoute "Date: ...\r\nConnection: ...\r\n\r\n" et renvoie la taille ajoutée.
+        static std::size_t append_tail(std::string &out, bool keep_alive);
+
+    private:
+        http::response<http::string_body> response_;
+        std::string head_;
+    };
+}
+
+#endif // PREBUILTRESPONSE_HPP
@@ -0,0 +1,141 @@
+#include "QueryString.hpp"
+#include <algorithm>
+
+namespace Softadastra
+{
+    namespace
+    {
+        int hex_value(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        // Octet décodé à la position i de raw, i avancé après la séquence ; -1 si invalide.
+        int decode_at(boost::beast::string_view raw, std::size_t &i)
+        {
+            const char c = raw[i++];
+            if (c == '+')
+            {
+                return ' ';
+            }
+            if (c != '%')
+            {
+                return static_cast<unsigned char>(c);
+            }
+            const int high = i + 1 < raw.size() ? hex_value(raw[i]) : -1;
+            const int low = high >= 0 ? hex_value(raw[i + 1]) : -1;
+            if (low < 0)
+            {
+                return -1;
+            }
+            i += 2;
+            return high * 16 + low;
+        }
+
+        // Nom encodé comparé à name sans le décoder dans un tampon.
+        bool name_equals(boost::beast::string_view raw, boost::beast::string_view name)
+        {
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < raw.size())
+            {
+                const int c = decode_at(raw, i);
+                if (c < 0 || j == name.size() || static_cast<unsigned char>(name[j++]) != c)
+                {
+                    return false;
+                }
+            }
+            return j == name.size();
+        }
+    }
+
+    Target split_target(boost::beast::string_view target)
+    {
+        Target result;
+        const std::size_t question = target.find('?');
+        const std::size_t hash = target.find('#');
+        result.path = target.substr(0, std::min(question, hash));
+        if (question != boost::beast::string_view::npos && question < hash)
+        {
+            result.query = target.substr(question + 1, hash == boost::beast::string_view::npos ? hash : hash - question - 1);
+        }
+        return result;
+    }
+
+    void QueryString::iterator::next()
+    {
+        // Les paires vides ("a=1&&b=2") sont sautées.
+        while (!rest_.empty())
+        {
+            const std::size_t amp = rest_.find('&');
+            const boost::beast::string_view pair = rest_.substr(0, amp);
+            rest_.remove_prefix(amp == boost::beast::string_view::npos ? rest_.size() : amp + 1);
+            if (pair.empty())
+            {
+                continue;
+            }
+            const std::size_t equals = pair.find('=');
+            current_.name = pair.substr(0, equals);
+            current_.value = equals == boost::beast::string_view::npos ? boost::beast::string_view() : pair.substr(equals + 1);
+            done_ = false;
+            return;
+        }
+        done_ = true;
+    }
+
+    bool QueryString::find(boost::beast::string_view name, boost::beast::string_view &raw_value) const
+    {
+        for (const Param &param : *this)
+        {
+            if (name_equals(param.name, name))
+            {
+                raw_value = param.value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool QueryString::contains(boost::beast::string_view name) const
+    {
+        boost::beast::string_view value;
+        return find(name, value);
+    }
+
+    bool QueryString::get(boost::beast::string_view name, char *buffer, std::size_t capacity,
+                          boost::beast::string_view &value) const
+    {
+        boost::beast::string_view raw;
+        return find(name, raw) && decode(raw, buffer, capacity, value);
+    }
+
+    bool QueryString::decode(boost::beast::string_view raw, char *buffer, std::size_t capacity,
+                             boost::beast::string_view &decoded)
+    {
+        std::size_t size = 0;
+        std::size_t i = 0;
+        while (i < raw.size())
+        {
+            const int c = decode_at(raw, i);
+            if (c < 0 || size == capacity)
+            {
+                return false;
+            }
+            buffer[size++] = static_cast<char>(c);
+        }
+        decoded = boost::beast::string_view(buffer, size);
+        return true;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef QUERYSTRING_HPP
+#define QUERYSTRING_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http.hpp>
+#include <cstddef>
+#include <iterator>
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Cible découpée une fois : le Router ne voit que path, les handlers lisent query.
+    struct Target
+    {
+        boost::beast::string_view path;
+        boost::beast::string_view query; // sans '?' ni fragment
+    };
+
+    Target split_target(boost::beast::string_view target);
+
+    // Lecture paresseuse de "a=1&b=x%20y" : rien n'est découpé ni copié à la construction,
+    // chaque recherche parcourt la chaîne, et les valeurs ne sont décodées (%XX, '+')
+    // que sur demande, dans un tampon fourni par l'appelant.
+    class QueryString
+    {
+    public:
+        // Paire telle qu'elle apparaît dans la requête, encodée.
+        struct Param
+        {
+            boost::beast::string_view name;
+            boost::beast::string_view value;
+        };
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Param;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Param *;
+            using reference = const Param &;
+
+            iterator() = default;
+            explicit iterator(boost::beast::string_view rest) : rest_(rest) { next(); }
+
+            reference operator*() const { return current_; }
+            pointer operator->() const { return &current_; }
+            iterator &operator++()
+            {
+                next();
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                next();
+                return previous;
+            }
+            bool operator==(const iterator &other) const { return done_ == other.done_ && (done_ || rest_.data() == other.rest_.data()); }
+            bool operator!=(const iterator &other) const { return !(*this == other); }
+
+        private:
+            void next();
+
+            boost::beast::string_view rest_;
+            Param current_;
+            bool done_ = true;
+        };
+
+        QueryString() = default;
+        explicit QueryString(boost::beast::string_view query) : query_(query) {}
+        explicit QueryString(const http::request<http::string_body> &req) : query_(split_target(req.target()).query) {}
+
+        iterator begin() const { return iterator(query_); }
+        iterator end() const { return iterator(); }
+        bool empty() const { return query_.empty(); }
+        boost::beast::string_view raw() const { return query_; }
+
+        // Valeur encodée du premier paramètre dont le nom, une fois décodé, vaut name.
+        bool find(boost::beast::string_view name, boost::beast::string_view &raw_value) const;
+        bool contains(boost::beast::string_view name) const;
+        // Valeur décodée dans buffer ; false si absente, mal encodée ou plus longue que capacity.
+        bool get(boost::beast::string_view name, char *buffer, std::size_t capacity,
+                 boost::beast::string_view &value) const;
+        template <std::size_t N>
+        bool get(boost::beast::string_view name, char (&buffer)[N], boost::beast::string_view &value) const
+        {
+            return get(name, buffer, N, value);
+        }
+
+        // '+' devient une espace, %XX l'octet correspondant.
+        static bool decode(boost::beast::string_view raw, char *buffer, std::size_t capacity,
+                           boost::beast::string_view &decoded);
+
+    private:
+        boost::beast::string_view query_;
+    };
+}
+
+#endif // QUERYSTRING_HPP
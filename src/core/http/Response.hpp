@@ -11,6 +11,8 @@
 #include <fstream>
 #include <iostream>
 #include <boost/filesystem.hpp>
+#include "HttpDate.hpp"
+#include "ETag.hpp"
 
 using json = nlohmann::json;
 namespace http = boost::beast::http;
@@ -30,13 +32,7 @@ namespace Softadastra
             res.result(status);
             res.set(http::field::content_type, content_type);
             res.set(http::field::server, "Softadastra");
-            auto now = std::chrono::system_clock::now();
-            std::time_t now_time_t = std::chrono::system_clock::to_time_t(now);
-            std::tm tm = *std::gmtime(&now_time_t);
-            std::ostringstream oss;
-            oss << std::put_time(&tm, "%a, %d %b %Y %H:%M:%S GMT");
-            std::string date = oss.str();
-            res.set(http::field::date, date);
+            res.set(http::field::date, HttpDate::now());
             res.body() = json{{"message", message}}.dump();
         }
 
@@ -57,19 +53,14 @@ namespace Softadastra
 
         static void no_content_response(
             http::response<http::string_body> &res,
-            const std::string &message = "No Content")
+            const std::string &message [[maybe_unused]] = "No Content")
         {
+            // Une réponse 204 n'a jamais de corps : sur une connexion persistante,
+            // ces octets seraient lus comme le début de la réponse suivante.
             res.result(http::status::no_content);
-            res.set(http::field::content_type, "application/json");
-            res.body() = json{{"message", message}}.dump();
+            res.body().clear();
             res.set(http::field::server, "Softadastra");
-            auto now = std::chrono::system_clock::now();
-            std::time_t now_time_t = std::chrono::system_clock::to_time_t(now);
-            std::tm tm = *std::gmtime(&now_time_t);
-            std::ostringstream oss;
-            oss << std::put_time(&tm, "%a, %d %b %Y %H:%M:%S GMT");
-            std::string date = oss.str();
-            res.set(http::field::date, date);
+            res.set(http::field::date, HttpDate::now());
         }
 
         static void redirect_response(http::response<http::string_body> &res,
@@ -80,13 +71,26 @@ namespace Softadastra
             res.set(http::field::content_type, "application/json");
             res.body() = json{{"message", "Redirecting to " + location}}.dump();
             res.set(http::field::server, "Softadastra");
-            auto now = std::chrono::system_clock::now();
-            std::time_t now_time_t = std::chrono::system_clock::to_time_t(now);
-            std::tm tm = *std::gmtime(&now_time_t);
-            std::ostringstream oss;
-            oss << std::put_time(&tm, "%a, %d %b %Y %H:%M:%S GMT");
-            std::string date = oss.str();
-            res.set(http::field::date, date);
+            res.set(http::field::date, HttpDate::now());
+        }
+
+        // ETag tiré d'une version de la ressource (compteur, updated_at...) : true si le
+        // client a déjà cette version ; res est alors un 304 et le handler peut s'arrêter
+        // avant de sérialiser.
+        static bool not_modified(const http::request<http::string_body> &req,
+                                 http::response<http::string_body> &res,
+                                 const std::string &version)
+        {
+            const std::string etag = etag_for_version(version);
+            res.set(http::field::etag, etag);
+            if (!etag_matches(req[http::field::if_none_match], etag))
+            {
+                return false;
+            }
+            res.set(http::field::server, "Softadastra");
+            res.set(http::field::date, HttpDate::now());
+            make_not_modified(res);
+            return true;
         }
 
         static void json_response(http::response<http::string_body> &res,
@@ -96,14 +100,7 @@ namespace Softadastra
             res.set(http::field::content_type, "application/json");
             res.body() = data.dump();
             res.set(http::field::server, "Softadastra");
-            auto now = std::chrono::system_clock::now();
-            std::time_t now_time_t = std::chrono::system_clock::to_time_t(now);
-            std::tm tm = *std::gmtime(&now_time_t);
-
-            std::ostringstream oss;
-            oss << std::put_time(&tm, "%a, %d %b %Y %H:%M:%S GMT");
-            std::string date = oss.str();
-            res.set(http::field::date, date);
+            res.set(http::field::date, HttpDate::now());
         }
     };
 }
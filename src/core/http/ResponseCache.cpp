@@ -0,0 +1,254 @@
+#include "ResponseCache.hpp"
+#include <algorithm>
+
+namespace Softadastra
+{
+    ResponseCache::ResponseCache(const Options &options)
+        : options_(options),
+          shard_capacity_(std::max<std::size_t>(1, options.max_entries / SHARDS)),
+          shards_(),
+          hits_(0),
+          stale_hits_(0),
+          misses_(0),
+          waits_(0),
+          uncacheable_(0),
+          evictions_(0)
+    {
+    }
+
+    const ResponseCache::Policy *ResponseCache::policy(const std::string &route) const
+    {
+        if (!options_.enabled)
+        {
+            return nullptr;
+        }
+        auto it = options_.routes.find(route);
+        return it == options_.routes.end() ? nullptr : &it->second;
+    }
+
+    bool ResponseCache::make_key(const http::request<http::string_body> &req, const Policy &policy, std::string &key)
+    {
+        // Réponse propre à l'utilisateur : jamais partagée, sauf si la route le prévoit.
+        for (const http::field field : {http::field::authorization, http::field::cookie})
+        {
+            if (req.find(field) != req.end() &&
+                std::none_of(policy.vary.begin(), policy.vary.end(), [&](const std::string &name)
+                             { return boost::beast::iequals(name, http::to_string(field)); }))
+            {
+                return false;
+            }
+        }
+
+        const auto target = req.target();
+        const auto accept_encoding = req[http::field::accept_encoding];
+        key.assign(target.data(), target.size());
+        key.push_back('\0');
+        key.append(accept_encoding.data(), accept_encoding.size());
+        for (const std::string &name : policy.vary)
+        {
+            const auto value = req[name];
+            key.push_back('\0');
+            key.append(value.data(), value.size());
+        }
+        return true;
+    }
+
+    ResponseCache::Shard &ResponseCache::shard_for(const std::string &key)
+    {
+        return shards_[std::hash<std::string>{}(key) % SHARDS];
+    }
+
+    ResponseCache::Lookup ResponseCache::lookup(const std::string &key)
+    {
+        Shard &shard = shard_for(key);
+        const auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end())
+        {
+            make_room(shard);
+            it = shard.entries.emplace(key, Entry()).first;
+            it->second.computing = true;
+            it->second.recency = shard.recency.insert(shard.recency.begin(), &it->first);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return Lookup{Outcome::Fill, nullptr};
+        }
+
+        Entry &entry = it->second;
+        touch(shard, entry);
+        if (entry.response && now < entry.fresh_until)
+        {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return Lookup{Outcome::Hit, entry.response};
+        }
+        if (entry.response && now < entry.stale_until)
+        {
+            stale_hits_.fetch_add(1, std::memory_order_relaxed);
+            if (entry.computing)
+            {
+                return Lookup{Outcome::Hit, entry.response};
+            }
+            entry.computing = true;
+            return Lookup{Outcome::Stale, entry.response};
+        }
+        if (entry.computing)
+        {
+            return Lookup{Outcome::Pending, nullptr};
+        }
+
+        // Trop ancienne pour être servie : recalcul au premier plan.
+        entry.response.reset();
+        entry.computing = true;
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return Lookup{Outcome::Fill, nullptr};
+    }
+
+    bool ResponseCache::wait(const std::string &key, Waiter waiter)
+    {
+        Shard &shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end() || !it->second.computing)
+        {
+            return false;
+        }
+        it->second.waiters.push_back(std::move(waiter));
+        waits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool ResponseCache::shareable(const http::response<http::string_body> &res)
+    {
+        // Réponse propre à la connexion qui l'a calculée : ni gardée ni transmise.
+        if (res.find(http::field::set_cookie) != res.end())
+        {
+            return false;
+        }
+        const auto cache_control = res[http::field::cache_control];
+        return cache_control.find("no-store") == boost::beast::string_view::npos &&
+               cache_control.find("private") == boost::beast::string_view::npos;
+    }
+
+    bool ResponseCache::cacheable(const http::response<http::string_body> &res) const
+    {
+        return res.result() == http::status::ok && res.body().size() <= options_.max_body_size && shareable(res);
+    }
+
+    std::shared_ptr<const PrebuiltResponse> ResponseCache::fill(const std::string &key, const Policy &policy,
+                                                                const http::response<http::string_body> &res)
+    {
+        // Sérialisation hors verrou : c'est elle qui sera servie aux requêtes suivantes.
+        auto response = std::make_shared<const PrebuiltResponse>(res);
+        const bool keep = cacheable(res);
+        const std::shared_ptr<const PrebuiltResponse> shared = shareable(res) ? response : nullptr;
+        if (!keep)
+        {
+            uncacheable_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::vector<Waiter> waiters;
+        {
+            Shard &shard = shard_for(key);
+            const auto now = Clock::now();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end())
+            {
+                Entry &entry = it->second;
+                waiters.swap(entry.waiters);
+                entry.computing = false;
+                if (keep)
+                {
+                    entry.response = response;
+                    entry.fresh_until = now + policy.ttl;
+                    entry.stale_until = entry.fresh_until + policy.stale;
+                }
+                else if (!entry.response)
+                {
+                    // Rien à garder au premier calcul. Une entrée périmée reste servie
+                    // jusqu'à la fin de sa fenêtre.
+                    erase(shard, it);
+                }
+            }
+        }
+
+        for (Waiter &waiter : waiters)
+        {
+            waiter(shared);
+        }
+        return response;
+    }
+
+    void ResponseCache::abandon(const std::string &key)
+    {
+        std::vector<Waiter> waiters;
+        {
+            Shard &shard = shard_for(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it == shard.entries.end())
+            {
+                return;
+            }
+            waiters.swap(it->second.waiters);
+            it->second.computing = false;
+            if (!it->second.response)
+            {
+                erase(shard, it);
+            }
+        }
+
+        for (Waiter &waiter : waiters)
+        {
+            waiter(nullptr);
+        }
+    }
+
+    void ResponseCache::touch(Shard &shard, Entry &entry)
+    {
+        shard.recency.splice(shard.recency.begin(), shard.recency, entry.recency);
+    }
+
+    void ResponseCache::erase(Shard &shard, Entries::iterator it)
+    {
+        shard.recency.erase(it->second.recency);
+        shard.entries.erase(it);
+    }
+
+    void ResponseCache::make_room(Shard &shard)
+    {
+        // Éviction de la moins récemment utilisée. Une entrée en cours de calcul (des
+        // requêtes peuvent l'attendre) repasse en tête : au plus un tour de liste.
+        std::size_t skipped = 0;
+        while (shard.entries.size() >= shard_capacity_ && skipped < shard.recency.size())
+        {
+            auto it = shard.entries.find(*shard.recency.back());
+            if (it->second.computing)
+            {
+                touch(shard, it->second);
+                ++skipped;
+                continue;
+            }
+            erase(shard, it);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ResponseCache::Stats ResponseCache::stats() const
+    {
+        std::size_t entries = 0;
+        for (const Shard &shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            entries += shard.entries.size();
+        }
+        return Stats{hits_.load(std::memory_order_relaxed),
+                     stale_hits_.load(std::memory_order_relaxed),
+                     misses_.load(std::memory_order_relaxed),
+                     waits_.load(std::memory_order_relaxed),
+                     uncacheable_.load(std::memory_order_relaxed),
+                     evictions_.load(std::memory_order_relaxed),
+                     entries};
+    }
+}
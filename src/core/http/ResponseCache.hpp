@@ -0,0 +1,146 @@
+#ifndef RESPONSECACHE_HPP
+#define RESPONSECACHE_HPP
+
+#include <boost/beast/http.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PrebuiltResponse.hpp"
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Micro-cache des réponses GET, devant le Router : une route qui tolère quelques
+    // secondes de retard (/users, /products/{id:int}) n'est recalculée qu'une fois par ttl,
+    // quel que soit le nombre de clients. Les réponses sont gardées sérialisées
+    // (PrebuiltResponse) et partagées telles quelles par toutes les connexions.
+    //
+    // Un seul calcul par clé à la fois : les requêtes qui arrivent pendant le premier
+    // calcul attendent son résultat, et une entrée périmée (dans la fenêtre "stale")
+    // continue d'être servie pendant qu'un seul recalcul tourne en arrière-plan.
+    class ResponseCache
+    {
+    public:
+        struct Policy
+        {
+            std::chrono::milliseconds ttl{1000};
+            std::chrono::milliseconds stale{0};
+            std::vector<std::string> vary; // en-têtes de requête ajoutés à la clé
+        };
+
+        struct Options
+        {
+            bool enabled = false;
+            std::size_t max_entries = 10000; // au-delà, la moins récemment utilisée du shard sort
+            std::size_t max_body_size = 1024 * 1024; // au-delà, la réponse n'est pas gardée
+            std::unordered_map<std::string, Policy> routes; // clé : motif de la route
+        };
+
+        enum class Outcome
+        {
+            Hit,     // réponse fraîche, ou périmée pendant qu'un recalcul tourne déjà
+            Stale,   // réponse périmée : la servir et lancer le recalcul
+            Fill,    // à calculer, puis fill() ; les autres requêtes attendent
+            Pending  // calcul en cours : wait()
+        };
+
+        struct Lookup
+        {
+            Outcome outcome;
+            std::shared_ptr<const PrebuiltResponse> response; // Hit et Stale
+        };
+
+        // nullptr : calcul abandonné, la requête doit être traitée sans le cache.
+        using Waiter = std::function<void(std::shared_ptr<const PrebuiltResponse>)>;
+
+        struct Stats
+        {
+            std::uint64_t hits;
+            std::uint64_t stale_hits;
+            std::uint64_t misses;
+            std::uint64_t waits;       // requêtes qui ont attendu un calcul en cours
+            std::uint64_t uncacheable; // résultats non gardés (erreur, Set-Cookie...)
+            std::uint64_t evictions;
+            std::size_t entries;
+        };
+
+        explicit ResponseCache(const Options &options);
+        ResponseCache(const ResponseCache &) = delete;
+        ResponseCache &operator=(const ResponseCache &) = delete;
+
+        // Politique de la route (nullptr : pas de cache).
+        const Policy *policy(const std::string &route) const;
+        // Clé : cible, Accept-Encoding (la compression en dépend) et en-têtes "vary".
+        // false : requête à ne pas mettre en cache (Authorization, Cookie non listés).
+        static bool make_key(const http::request<http::string_body> &req, const Policy &policy, std::string &key);
+
+        Lookup lookup(const std::string &key);
+        // Attend le calcul en cours ; false s'il s'est terminé entre-temps (refaire lookup()).
+        bool wait(const std::string &key, Waiter waiter);
+        // Résultat d'un calcul (Fill ou Stale) : gardé s'il s'y prête, et transmis aux
+        // requêtes en attente s'il n'est propre à personne (une erreur, par exemple).
+        // Set-Cookie, Cache-Control private ou no-store : les requêtes en attente sont
+        // réveillées avec nullptr et recalculent chacune leur réponse.
+        std::shared_ptr<const PrebuiltResponse> fill(const std::string &key, const Policy &policy,
+                                                     const http::response<http::string_body> &res);
+        // Calcul abandonné (pools saturés, connexion fermée avant la réponse) : les requêtes
+        // en attente sont réveillées avec nullptr, une entrée sans réponse est retirée.
+        void abandon(const std::string &key);
+        Stats stats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+        static constexpr std::size_t SHARDS = 16;
+
+        // Ordre d'utilisation du shard, la plus récente en tête. Les clés pointées sont
+        // celles de la table : un nœud d'unordered_map ne bouge pas au rehash.
+        using Recency = std::list<const std::string *>;
+
+        struct Entry
+        {
+            std::shared_ptr<const PrebuiltResponse> response; // nullptr : premier calcul en cours
+            Clock::time_point fresh_until;
+            Clock::time_point stale_until;
+            bool computing = false;
+            std::vector<Waiter> waiters;
+            Recency::iterator recency;
+        };
+
+        using Entries = std::unordered_map<std::string, Entry>;
+
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            Entries entries;
+            Recency recency;
+        };
+
+        Shard &shard_for(const std::string &key);
+        static bool shareable(const http::response<http::string_body> &res);
+        bool cacheable(const http::response<http::string_body> &res) const;
+        void touch(Shard &shard, Entry &entry);
+        void erase(Shard &shard, Entries::iterator it);
+        void make_room(Shard &shard);
+
+        const Options options_;
+        const std::size_t shard_capacity_;
+        std::array<Shard, SHARDS> shards_;
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> stale_hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::uint64_t> waits_;
+        std::atomic<std::uint64_t> uncacheable_;
+        std::atomic<std::uint64_t> evictions_;
+    };
+}
+
+#endif // RESPONSECACHE_HPP
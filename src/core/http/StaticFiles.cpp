@@ -0,0 +1,404 @@
+#include "StaticFiles.hpp"
+#include "Compression.hpp"
+#include "HttpDate.hpp"
+#include "ETag.hpp"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <strings.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/openat2.h>)
+#include <linux/openat2.h>
+#endif
+
+namespace Softadastra
+{
+    namespace
+    {
+        struct ContentType
+        {
+            const char *extension;
+            const char *type;
+        };
+
+        constexpr ContentType CONTENT_TYPES[] = {
+            {"html", "text/html; charset=utf-8"},
+            {"htm", "text/html; charset=utf-8"},
+            {"css", "text/css; charset=utf-8"},
+            {"js", "text/javascript; charset=utf-8"},
+            {"mjs", "text/javascript; charset=utf-8"},
+            {"json", "application/json"},
+            {"map", "application/json"},
+            {"txt", "text/plain; charset=utf-8"},
+            {"xml", "application/xml"},
+            {"svg", "image/svg+xml"},
+            {"png", "image/png"},
+            {"jpg", "image/jpeg"},
+            {"jpeg", "image/jpeg"},
+            {"gif", "image/gif"},
+            {"webp", "image/webp"},
+            {"avif", "image/avif"},
+            {"ico", "image/x-icon"},
+            {"woff", "font/woff"},
+            {"woff2", "font/woff2"},
+            {"wasm", "application/wasm"},
+            {"pdf", "application/pdf"}};
+
+        const char *content_type_for(const std::string &path)
+        {
+            const std::size_t dot = path.rfind('.');
+            if (dot != std::string::npos && path.find('/', dot) == std::string::npos)
+            {
+                const char *extension = path.c_str() + dot + 1;
+                for (const ContentType &entry : CONTENT_TYPES)
+                {
+                    if (strcasecmp(entry.extension, extension) == 0)
+                    {
+                        return entry.type;
+                    }
+                }
+            }
+            return "application/octet-stream";
+        }
+
+        // Noms avec empreinte : le contenu ne change jamais. Le reste est revalidé.
+        constexpr const char *CACHE_IMMUTABLE = "public, max-age=31536000, immutable";
+        constexpr const char *CACHE_REVALIDATE = "no-cache";
+
+        int hex_value(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        int open_beneath(int root_fd, const char *relative)
+        {
+#if defined(SYS_openat2) && defined(RESOLVE_BENEATH)
+            // Le noyau refuse aussi les liens symboliques qui sortiraient de la racine.
+            open_how how{};
+            how.flags = O_RDONLY | O_CLOEXEC;
+            how.resolve = RESOLVE_BENEATH;
+            const int fd = static_cast<int>(::syscall(SYS_openat2, root_fd, relative, &how, sizeof(how)));
+            if (fd >= 0 || errno != ENOSYS)
+            {
+                return fd;
+            }
+#endif
+            return ::openat(root_fd, relative, O_RDONLY | O_CLOEXEC);
+        }
+    }
+
+    StaticFile::~StaticFile()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+
+    StaticFiles::StaticFiles(const Options &options)
+        : options_(options),
+          root_fd_(::open(options.root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)),
+          mutex_(),
+          cache_(),
+          hits_(0),
+          misses_(0),
+          rejected_(0),
+          precompressed_(0)
+    {
+        if (root_fd_ < 0)
+        {
+            throw std::runtime_error("Cannot open static root " + options_.root + ": " + std::strerror(errno));
+        }
+        if (!options_.manifest.empty())
+        {
+            try
+            {
+                load_manifest();
+            }
+            catch (...)
+            {
+                ::close(root_fd_);
+                throw;
+            }
+        }
+        spdlog::info("Serving static files from {} under {}{}", options_.root, options_.prefix,
+                     options_.manifest.empty() ? "" : " (precompressed assets)");
+    }
+
+    StaticFiles::~StaticFiles()
+    {
+        ::close(root_fd_);
+    }
+
+    void StaticFiles::load_manifest()
+    {
+        const std::string path = options_.root + "/" + options_.manifest;
+        std::ifstream input(path, std::ios::in | std::ios::binary);
+        if (!input.is_open())
+        {
+            throw std::runtime_error("Cannot open asset manifest " + path);
+        }
+
+        try
+        {
+            nlohmann::json manifest;
+            input >> manifest;
+            if (manifest.value("version", 0) != 1)
+            {
+                throw std::runtime_error("unsupported manifest version");
+            }
+            for (const auto &[name, entry] : manifest.at("files").items())
+            {
+                Asset asset;
+                asset.file = entry.at("file").get<std::string>();
+                asset.immutable = entry.value("immutable", false);
+                if (entry.contains("encodings"))
+                {
+                    asset.brotli = entry.at("encodings").value("br", "");
+                    asset.gzip = entry.at("encodings").value("gzip", "");
+                }
+                assets_.emplace(name, std::move(asset));
+            }
+        }
+        catch (const std::exception &e)
+        {
+            throw std::runtime_error("Invalid asset manifest " + path + ": " + e.what());
+        }
+    }
+
+    bool StaticFiles::matches(boost::beast::string_view target) const
+    {
+        return target.size() >= options_.prefix.size() &&
+               target.compare(0, options_.prefix.size(), options_.prefix) == 0;
+    }
+
+    bool StaticFiles::resolve(boost::beast::string_view target, std::string &relative) const
+    {
+        // Chemin relatif à la racine, décodé ; tout segment vide, "." ou ".." (ou fichier
+        // caché) est refusé avant le moindre appel système.
+        const std::size_t end = target.find_first_of("?#");
+        const boost::beast::string_view path = target.substr(options_.prefix.size(),
+                                                             end == boost::beast::string_view::npos ? boost::beast::string_view::npos
+                                                                                                    : end - options_.prefix.size());
+        relative.clear();
+        relative.reserve(path.size() + options_.index.size());
+        for (std::size_t i = 0; i < path.size(); ++i)
+        {
+            char c = path[i];
+            if (c == '%')
+            {
+                const int high = i + 2 < path.size() ? hex_value(path[i + 1]) : -1;
+                const int low = high >= 0 ? hex_value(path[i + 2]) : -1;
+                if (low < 0)
+                {
+                    return false;
+                }
+                c = static_cast<char>(high * 16 + low);
+                i += 2;
+            }
+            if (c == '\0' || c == '\\')
+            {
+                return false;
+            }
+            if ((c == '/' || c == '.') && (relative.empty() || relative.back() == '/'))
+            {
+                return false;
+            }
+            relative.push_back(c);
+        }
+
+        if (relative.empty() || relative.back() == '/')
+        {
+            relative += options_.index;
+        }
+        return true;
+    }
+
+    StaticFiles::Lookup StaticFiles::find(boost::beast::string_view target, boost::beast::string_view accept_encoding,
+                                          std::shared_ptr<const StaticFile> &file)
+    {
+        std::string relative;
+        if (!resolve(target, relative))
+        {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return Lookup::Invalid;
+        }
+
+        Variant variant{&relative, nullptr, nullptr, false};
+        std::string key = relative;
+        if (!options_.manifest.empty())
+        {
+            // Hors du manifeste : introuvable, sans toucher au système de fichiers.
+            auto asset = assets_.find(relative);
+            if (asset == assets_.end())
+            {
+                return Lookup::NotFound;
+            }
+
+            const Asset &entry = asset->second;
+            variant.path = &entry.file;
+            variant.cache_control = entry.immutable ? CACHE_IMMUTABLE : CACHE_REVALIDATE;
+            variant.vary = !entry.brotli.empty() || !entry.gzip.empty();
+            if (!entry.brotli.empty() && accepts_encoding(accept_encoding, "br"))
+            {
+                variant.path = &entry.brotli;
+                variant.content_encoding = "br";
+            }
+            else if (!entry.gzip.empty() && accepts_encoding(accept_encoding, "gzip"))
+            {
+                variant.path = &entry.gzip;
+                variant.content_encoding = "gzip";
+            }
+            if (variant.content_encoding)
+            {
+                // '\0' ne peut pas figurer dans un chemin résolu : clé sans ambiguïté.
+                key.push_back('\0');
+                key += variant.content_encoding;
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = cache_.find(key);
+            if (it != cache_.end() && now - it->second->opened < options_.revalidate)
+            {
+                file = it->second;
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                if (variant.content_encoding)
+                {
+                    precompressed_.fetch_add(1, std::memory_order_relaxed);
+                }
+                return Lookup::Found;
+            }
+        }
+
+        // Absent ou trop ancien : réouverture, ce qui suit aussi les remplacements
+        // (rename atomique d'un déploiement) et les modifications de taille.
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        file = open_file(relative, variant);
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (!file)
+        {
+            cache_.erase(key);
+            return Lookup::NotFound;
+        }
+        if (variant.content_encoding)
+        {
+            precompressed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (cache_.size() >= options_.max_open_files && cache_.find(key) == cache_.end())
+        {
+            for (auto it = cache_.begin(); it != cache_.end();)
+            {
+                it = now - it->second->opened >= options_.revalidate ? cache_.erase(it) : std::next(it);
+            }
+        }
+        if (cache_.size() < options_.max_open_files || cache_.find(key) != cache_.end())
+        {
+            cache_[key] = file;
+        }
+        return Lookup::Found;
+    }
+
+    std::shared_ptr<const StaticFile> StaticFiles::open_file(const std::string &relative, const Variant &variant) const
+    {
+        const int fd = open_beneath(root_fd_, variant.path->c_str());
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        auto file = std::make_shared<StaticFile>();
+        file->fd = fd;
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            return nullptr;
+        }
+
+        // Type du fichier demandé, pas de sa variante .br/.gz.
+        file->size = static_cast<std::uint64_t>(st.st_size);
+        file->content_type = content_type_for(relative);
+        file->last_modified = HttpDate::format(st.st_mtime);
+        file->mtime = st.st_mtime;
+        file->etag = etag_for_file(static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec, file->size);
+        file->content_encoding = variant.content_encoding;
+        file->cache_control = variant.cache_control;
+        file->vary = variant.vary;
+        file->opened = std::chrono::steady_clock::now();
+        return file;
+    }
+
+    void StaticFiles::prepare_response(const StaticFile &file, http::response<http::string_body> &res)
+    {
+        res.result(http::status::ok);
+        res.set(http::field::server, "Softadastra");
+        res.set(http::field::date, HttpDate::now());
+        res.set(http::field::content_type, file.content_type);
+        res.set(http::field::last_modified, file.last_modified);
+        res.set(http::field::etag, file.etag);
+        if (file.content_encoding)
+        {
+            res.set(http::field::content_encoding, file.content_encoding);
+        }
+        if (file.vary)
+        {
+            res.set(http::field::vary, "Accept-Encoding");
+        }
+        if (file.cache_control)
+        {
+            res.set(http::field::cache_control, file.cache_control);
+        }
+        res.content_length(file.size);
+    }
+
+    bool StaticFiles::not_modified(const StaticFile &file, const http::request<http::string_body> &req)
+    {
+        // If-Modified-Since n'est consulté qu'en l'absence d'If-None-Match (RFC 9110, 13.1.3).
+        const auto if_none_match = req[http::field::if_none_match];
+        if (!if_none_match.empty())
+        {
+            return etag_matches(if_none_match, file.etag);
+        }
+        const auto if_modified_since = req[http::field::if_modified_since];
+        if (if_modified_since.empty())
+        {
+            return false;
+        }
+        const std::time_t since = HttpDate::parse(if_modified_since);
+        return since >= 0 && file.mtime <= since;
+    }
+
+    StaticFiles::Stats StaticFiles::stats() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return Stats{hits_.load(std::memory_order_relaxed),
+                     misses_.load(std::memory_order_relaxed),
+                     rejected_.load(std::memory_order_relaxed),
+                     precompressed_.load(std::memory_order_relaxed),
+                     cache_.size()};
+    }
+}
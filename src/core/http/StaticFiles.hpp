@@ -0,0 +1,127 @@
+#ifndef STATICFILES_HPP
+#define STATICFILES_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Fichier ouvert et prêt à partir par sendfile : le descripteur reste valide tant
+    // qu'une réponse le référence, même s'il a été retiré du cache entre-temps.
+    struct StaticFile
+    {
+        StaticFile() = default;
+        ~StaticFile();
+        StaticFile(const StaticFile &) = delete;
+        StaticFile &operator=(const StaticFile &) = delete;
+
+        int fd = -1;
+        std::uint64_t size = 0;
+        std::string content_type;
+        std::string last_modified; // format HTTP (IMF-fixdate)
+        std::time_t mtime = 0;
+        std::string etag;
+        const char *content_encoding = nullptr; // variante précompressée ("br", "gzip")
+        const char *cache_control = nullptr;
+        bool vary = false; // d'autres variantes existent : Vary: Accept-Encoding
+        std::chrono::steady_clock::time_point opened;
+    };
+
+    // Répertoire servi sous un préfixe d'URL (monté sur le Router). Les descripteurs et
+    // les métadonnées sont gardés en cache et rouverts au plus tous les "revalidate" :
+    // une requête servie depuis le cache ne coûte ni open() ni stat().
+    //
+    // Avec un manifeste (cmake/AssetPipeline.cmake), seuls les fichiers qu'il décrit sont
+    // servis, dans la meilleure variante précompressée acceptée par le client ; rien
+    // n'est compressé à la volée.
+    class StaticFiles
+    {
+    public:
+        struct Options
+        {
+            std::string root;
+            std::string prefix = "/app/";  // commence et finit par '/'
+            std::string index = "index.html";
+            std::size_t max_open_files = 1024;
+            std::chrono::seconds revalidate{2};
+            std::string manifest; // manifest.json, relatif à root ; vide : root servi tel quel
+        };
+
+        enum class Lookup
+        {
+            Found,
+            NotFound,
+            Invalid // chemin refusé (.., %00, encodage invalide...)
+        };
+
+        struct Stats
+        {
+            std::uint64_t hits;
+            std::uint64_t misses;
+            std::uint64_t rejected;
+            std::uint64_t precompressed; // réponses servies depuis une variante .br/.gz
+            std::size_t open_files;
+        };
+
+        explicit StaticFiles(const Options &options);
+        ~StaticFiles();
+        StaticFiles(const StaticFiles &) = delete;
+        StaticFiles &operator=(const StaticFiles &) = delete;
+
+        const std::string &prefix() const { return options_.prefix; }
+        bool matches(boost::beast::string_view target) const;
+
+        Lookup find(boost::beast::string_view target, boost::beast::string_view accept_encoding,
+                    std::shared_ptr<const StaticFile> &file);
+        // En-têtes d'une réponse 200 ; le corps part ensuite depuis file.fd.
+        static void prepare_response(const StaticFile &file, http::response<http::string_body> &res);
+        // Requête conditionnelle satisfaite par la copie du client : If-None-Match, ou à
+        // défaut If-Modified-Since.
+        static bool not_modified(const StaticFile &file, const http::request<http::string_body> &req);
+        Stats stats() const;
+
+    private:
+        struct Asset
+        {
+            std::string file;
+            std::string brotli; // vide : pas de variante
+            std::string gzip;
+            bool immutable = false;
+        };
+
+        // Fichier à ouvrir pour une requête, et ce qu'en dit la réponse.
+        struct Variant
+        {
+            const std::string *path;
+            const char *content_encoding;
+            const char *cache_control;
+            bool vary;
+        };
+
+        bool resolve(boost::beast::string_view target, std::string &relative) const;
+        void load_manifest();
+        std::shared_ptr<const StaticFile> open_file(const std::string &relative, const Variant &variant) const;
+
+        const Options options_;
+        int root_fd_;
+        std::unordered_map<std::string, Asset> assets_; // manifeste, clé : chemin de la requête
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<const StaticFile>> cache_; // clé : chemin de la requête
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::uint64_t> rejected_;
+        std::atomic<std::uint64_t> precompressed_;
+    };
+}
+
+#endif // STATICFILES_HPP
@@ -0,0 +1,150 @@
+#include "AsyncLog.hpp"
+#include <cmath>
+
+namespace Softadastra
+{
+    AsyncLog &AsyncLog::instance()
+    {
+        static AsyncLog log;
+        return log;
+    }
+
+    AsyncLog::AsyncLog()
+        : slots_(), mask_(0), enqueue_position_(0), dequeue_position_(0), running_(false), level_(spdlog::level::info),
+          access_period_(1), written_(0), dropped_(0), truncated_(0), writer_()
+    {
+    }
+
+    AsyncLog::~AsyncLog()
+    {
+        stop();
+    }
+
+    void AsyncLog::start(const Options &options)
+    {
+        level_.store(options.level, std::memory_order_relaxed);
+        spdlog::set_level(options.level); // appels spdlog directs (démarrage, erreurs)
+        access_period_.store(options.access_sample_rate > 0.0
+                                 ? static_cast<std::uint32_t>(std::max(1.0, std::round(1.0 / options.access_sample_rate)))
+                                 : 0,
+                             std::memory_order_relaxed);
+        if (running_.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (!slots_)
+        {
+            std::size_t capacity = 2;
+            while (capacity < options.queue_size)
+            {
+                capacity *= 2;
+            }
+            slots_ = std::make_unique<Slot[]>(capacity);
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            mask_ = capacity - 1;
+        }
+
+        running_.store(true, std::memory_order_release);
+        writer_ = std::thread([this]()
+                              { run(); });
+    }
+
+    void AsyncLog::stop()
+    {
+        if (!running_.exchange(false))
+        {
+            return;
+        }
+        if (writer_.joinable())
+        {
+            writer_.join();
+        }
+        write_pending();
+        spdlog::default_logger_raw()->flush();
+    }
+
+    AsyncLog::Slot *AsyncLog::claim()
+    {
+        // File bornée de D. Vyukov : chaque créneau porte le numéro du prochain tour qui
+        // peut l'utiliser. En retard d'un tour, l'anneau est plein.
+        std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot &slot = slots_[position & mask_];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0)
+            {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    return &slot;
+                }
+            }
+            else if (difference < 0)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            else
+            {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void AsyncLog::publish(Slot &slot)
+    {
+        const std::size_t position = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    bool AsyncLog::write_pending()
+    {
+        // Lignes dans l'ordre des créneaux ; une ligne en cours de formatage arrête la
+        // passe, la suivante la reprendra.
+        spdlog::logger *logger = spdlog::default_logger_raw();
+        bool wrote = false;
+        for (;;)
+        {
+            Slot &slot = slots_[dequeue_position_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1)
+            {
+                return wrote;
+            }
+
+            logger->log(slot.time, spdlog::source_loc{}, slot.level, spdlog::string_view_t(slot.text, slot.length));
+            written_.fetch_add(1, std::memory_order_relaxed);
+            if (slot.truncated)
+            {
+                truncated_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            slot.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+            ++dequeue_position_;
+            wrote = true;
+        }
+    }
+
+    void AsyncLog::run()
+    {
+        // Pas de réveil par les producteurs (un appel système par ligne) : le thread
+        // vide l'anneau puis dort 1 ms quand il est vide.
+        while (running_.load(std::memory_order_acquire))
+        {
+            if (!write_pending())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    AsyncLog::Stats AsyncLog::stats() const
+    {
+        return Stats{written_.load(std::memory_order_relaxed), dropped_.load(std::memory_order_relaxed),
+                     truncated_.load(std::memory_order_relaxed)};
+    }
+}
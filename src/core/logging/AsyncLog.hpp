@@ -0,0 +1,147 @@
+#ifndef ASYNCLOG_HPP
+#define ASYNCLOG_HPP
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// Niveau minimal compilé (SPDLOG_ACTIVE_LEVEL, info par défaut) : les appels en dessous
+// disparaissent du binaire. -DSPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_DEBUG pour les traces de
+// connexion, SPDLOG_LEVEL_WARN pour une build de production.
+#define SOFTADASTRA_LOG(level, ...)                                                         \
+    do                                                                                      \
+    {                                                                                       \
+        if constexpr (static_cast<int>(level) >= SPDLOG_ACTIVE_LEVEL)                       \
+        {                                                                                   \
+            ::Softadastra::AsyncLog &softadastra_log = ::Softadastra::AsyncLog::instance(); \
+            if (softadastra_log.should_log(level))                                          \
+            {                                                                               \
+                softadastra_log.log(level, __VA_ARGS__);                                    \
+            }                                                                               \
+        }                                                                                   \
+    } while (0)
+
+namespace Softadastra
+{
+    // Journal des chemins chauds (threads io, handlers). La ligne est formatée sur place
+    // dans un anneau lock-free à plusieurs producteurs ; un thread la passe ensuite au
+    // logger spdlog par défaut, avec l'heure de l'appel. Anneau plein : la ligne est
+    // perdue et comptée, un thread io n'attend jamais l'écriture sur la console.
+    //
+    // Avant start() et après stop(), les lignes sont écrites directement par spdlog.
+    class AsyncLog
+    {
+    public:
+        struct Options
+        {
+            spdlog::level::level_enum level = spdlog::level::info;
+            std::size_t queue_size = 8192; // lignes, arrondi à une puissance de deux
+            double access_sample_rate = 1.0; // part des requêtes dans le journal d'accès ; 0 : aucune
+        };
+
+        struct Stats
+        {
+            std::uint64_t written;
+            std::uint64_t dropped; // anneau plein
+            std::uint64_t truncated; // ligne plus longue que LINE_SIZE
+        };
+
+        static constexpr std::size_t LINE_SIZE = 224;
+
+        static AsyncLog &instance();
+
+        AsyncLog(const AsyncLog &) = delete;
+        AsyncLog &operator=(const AsyncLog &) = delete;
+
+        void start(const Options &options);
+        // Écrit ce qui reste dans l'anneau puis arrête le thread d'écriture.
+        void stop();
+
+        bool should_log(spdlog::level::level_enum level) const
+        {
+            return level >= level_.load(std::memory_order_relaxed);
+        }
+
+        // Vrai pour une requête sur 1 / access_sample_rate, compté par thread : pas
+        // d'écriture partagée entre threads io.
+        bool sample_access() const
+        {
+            const std::uint32_t period = access_period_.load(std::memory_order_relaxed);
+            if (period == 0 || !should_log(spdlog::level::info))
+            {
+                return false;
+            }
+            thread_local std::uint32_t counter = 0;
+            return ++counter % period == 0;
+        }
+
+        template <typename... Args>
+        void log(spdlog::level::level_enum level, fmt::format_string<Args...> format, Args &&...args)
+        {
+            Slot *slot = running_.load(std::memory_order_acquire) ? claim() : nullptr;
+            if (!slot)
+            {
+                if (!running_.load(std::memory_order_relaxed))
+                {
+                    spdlog::default_logger_raw()->log(level, format, std::forward<Args>(args)...);
+                }
+                return;
+            }
+
+            slot->level = level;
+            slot->time = spdlog::log_clock::now();
+            try
+            {
+                const auto result = fmt::format_to_n(slot->text, LINE_SIZE, format, std::forward<Args>(args)...);
+                slot->length = static_cast<std::uint16_t>(std::min<std::size_t>(result.size, LINE_SIZE));
+                slot->truncated = result.size > LINE_SIZE;
+            }
+            catch (...)
+            {
+                slot->length = 0; // le créneau doit quand même être rendu au thread d'écriture
+                slot->truncated = false;
+            }
+            publish(*slot);
+        }
+
+        Stats stats() const;
+
+    private:
+        struct Slot
+        {
+            std::atomic<std::size_t> sequence{0};
+            spdlog::level::level_enum level = spdlog::level::info;
+            spdlog::log_clock::time_point time;
+            std::uint16_t length = 0;
+            bool truncated = false;
+            char text[LINE_SIZE];
+        };
+
+        AsyncLog();
+        ~AsyncLog();
+
+        Slot *claim();
+        void publish(Slot &slot);
+        bool write_pending();
+        void run();
+
+        std::unique_ptr<Slot[]> slots_;
+        std::size_t mask_;
+        alignas(64) std::atomic<std::size_t> enqueue_position_;
+        alignas(64) std::size_t dequeue_position_; // thread d'écriture seulement
+        std::atomic<bool> running_;
+        std::atomic<spdlog::level::level_enum> level_;
+        std::atomic<std::uint32_t> access_period_;
+        std::atomic<std::uint64_t> written_;
+        std::atomic<std::uint64_t> dropped_;
+        std::atomic<std::uint64_t> truncated_;
+        std::thread writer_;
+    };
+}
+
+#endif // ASYNCLOG_HPP
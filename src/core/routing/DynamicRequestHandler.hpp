@@ -1,33 +1,47 @@
 #ifndef DYNAMICREQUESTHANDLER_HPP
 #define DYNAMICREQUESTHANDLER_HPP
 
-#include "IRequestHandler.hpp"
-#include <algorithm>
-#include <string>
-#include <unordered_map>
-#include <functional>
-#include <boost/beast/http.hpp>
+#include "RouteHandler.hpp"
+#include <type_traits>
+#include <utility>
 
 namespace Softadastra
 {
-    class DynamicRequestHandler : public IRequestHandler
+    // Méthodes autres que GET : corps JSON obligatoire. false, et res renseignée, sinon.
+    bool require_json_body(const http::request<http::string_body> &req, http::response<http::string_body> &res);
+
+    // Handler d'une route à paramètres : handler(params, res), ou handler(req, params, res)
+    // pour voir aussi la requête (corps, en-têtes conditionnels, Accept...). Les paramètres
+    // sont passés à chaque appel : une même instance sert toutes les requêtes sans état.
+    template <typename Handler>
+    class DynamicRequestHandler
     {
     public:
-        explicit DynamicRequestHandler(std::function<void(const std::unordered_map<std::string, std::string> &,
-                                                          http::response<http::string_body> &)>
-                                           handler);
-        ~DynamicRequestHandler();
-        void handle_request(const http::request<http::string_body> &req,
-                            http::response<http::string_body> &res) override;
-        void set_params(
-            const std::unordered_map<std::string, std::string> &params,
-            http::response<http::string_body> &res);
+        using Params = RouteParams;
+
+        explicit DynamicRequestHandler(Handler handler) : handler_(std::move(handler)) {}
+
+        void operator()(const http::request<http::string_body> &req, const Params &params,
+                        http::response<http::string_body> &res)
+        {
+            if (req.method() != http::verb::get && !require_json_body(req, res))
+            {
+                return;
+            }
+
+            if constexpr (std::is_invocable_v<Handler &, const http::request<http::string_body> &, const Params &,
+                                              http::response<http::string_body> &>)
+            {
+                handler_(req, params, res);
+            }
+            else
+            {
+                handler_(params, res);
+            }
+        }
 
     private:
-        std::unordered_map<std::string, std::string> params_;
-        std::function<void(const std::unordered_map<std::string, std::string> &,
-                           http::response<http::string_body> &)>
-            handler_;
+        Handler handler_;
     };
 };
 
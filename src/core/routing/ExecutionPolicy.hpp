@@ -0,0 +1,15 @@
+#ifndef EXECUTIONPOLICY_HPP
+#define EXECUTIONPOLICY_HPP
+
+namespace Softadastra
+{
+    // Où s'exécute le handler d'une route.
+    enum class ExecutionPolicy
+    {
+        Inline,   // directement sur le thread io de la session (strand), sans changement de thread
+        CpuPool,  // pool de requêtes : calcul long mais non bloquant
+        Blocking  // pool dédié aux appels bloquants (MySQL, fichiers...), réponse reprise sur la connexion
+    };
+}
+
+#endif // EXECUTIONPOLICY_HPP
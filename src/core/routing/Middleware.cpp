@@ -0,0 +1,115 @@
+#include "Middleware.hpp"
+#include "http/Response.hpp"
+#include "logging/AsyncLog.hpp"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <regex>
+
+namespace Softadastra
+{
+    namespace
+    {
+        std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        bool waf_before(const http::request<http::string_body> &req, http::response<http::string_body> &res)
+        {
+            // Compilées une fois ; regex_search sur une regex const est sûr entre threads.
+            static const std::regex xss_pattern(R"(<script.*?>.*?</script>)", std::regex::icase);
+            static const std::regex sql_pattern(R"((\bUNION\b|\bSELECT\b|\bINSERT\b|\bDELETE\b|\bUPDATE\b|\bDROP\b))", std::regex::icase);
+
+            const boost::beast::string_view target = req.target();
+            if (std::regex_search(target.begin(), target.end(), xss_pattern))
+            {
+                SOFTADASTRA_LOG(spdlog::level::warn, "Possible XSS attack detected in URL: {}", target);
+            }
+            else if (std::regex_search(req.body(), sql_pattern))
+            {
+                SOFTADASTRA_LOG(spdlog::level::warn, "Possible SQL injection detected in body: {}", req.body());
+            }
+            else
+            {
+                return true;
+            }
+
+            SOFTADASTRA_LOG(spdlog::level::warn, "Request blocked by WAF.");
+            Response::error_response(res, http::status::bad_request, "Request blocked due to security policy");
+            return false;
+        }
+
+        bool cors_before(const http::request<http::string_body> &req, http::response<http::string_body> &res)
+        {
+            if (req.method() != http::verb::options)
+            {
+                return true;
+            }
+            res.result(http::status::no_content);
+            res.set(http::field::access_control_allow_origin, "*");
+            res.set(http::field::access_control_allow_methods, "GET, POST, PUT, DELETE, PATCH, OPTIONS, HEAD");
+            res.set(http::field::access_control_allow_headers, "Content-Type, Authorization");
+            return false;
+        }
+    }
+
+    MiddlewareStats::Snapshot MiddlewareStats::snapshot() const
+    {
+        return Snapshot{calls.load(std::memory_order_relaxed), stopped.load(std::memory_order_relaxed),
+                        before_ns.load(std::memory_order_relaxed), after_ns.load(std::memory_order_relaxed)};
+    }
+
+    void MiddlewarePipeline::append(const Middleware &middleware, MiddlewareStats &stats)
+    {
+        stages_.push_back(Stage{middleware.before, middleware.after, &stats});
+        has_after_ = has_after_ || middleware.after;
+    }
+
+    bool MiddlewarePipeline::run_before(const http::request<http::string_body> &req,
+                                        http::response<http::string_body> &res) const
+    {
+        for (const Stage &stage : stages_)
+        {
+            stage.stats->calls.fetch_add(1, std::memory_order_relaxed);
+            if (!stage.before)
+            {
+                continue;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            const bool proceed = stage.before(req, res);
+            stage.stats->before_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+            if (!proceed)
+            {
+                stage.stats->stopped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void MiddlewarePipeline::run_after(const http::request<http::string_body> &req,
+                                       http::response<http::string_body> &res) const
+    {
+        for (auto stage = stages_.rbegin(); stage != stages_.rend(); ++stage)
+        {
+            if (!stage->after)
+            {
+                continue;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            stage->after(req, res);
+            stage->stats->after_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+        }
+    }
+
+    Middleware waf_middleware()
+    {
+        return Middleware{"waf", &waf_before, nullptr};
+    }
+
+    Middleware cors_middleware()
+    {
+        return Middleware{"cors", &cors_before, nullptr};
+    }
+}
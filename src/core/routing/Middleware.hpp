@@ -0,0 +1,77 @@
+#ifndef MIDDLEWARE_HPP
+#define MIDDLEWARE_HPP
+
+#include <boost/beast/http.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Étape transversale d'une route (WAF, CORS...). before() voit la requête avant le
+    // cache et le handler : false arrête la chaîne et la réponse écrite dans res part telle
+    // quelle. after() complète la réponse du handler, dans l'ordre inverse des before().
+    struct Middleware
+    {
+        using Before = bool (*)(const http::request<http::string_body> &, http::response<http::string_body> &);
+        using After = void (*)(const http::request<http::string_body> &, http::response<http::string_body> &);
+
+        std::string name;
+        Before before = nullptr;
+        After after = nullptr;
+    };
+
+    // Coût cumulé d'un middleware, toutes routes confondues (/server-status).
+    struct MiddlewareStats
+    {
+        struct Snapshot
+        {
+            std::uint64_t calls;
+            std::uint64_t stopped; // before() a répondu à la place du handler
+            std::uint64_t before_ns;
+            std::uint64_t after_ns;
+        };
+
+        Snapshot snapshot() const;
+
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> stopped{0};
+        std::atomic<std::uint64_t> before_ns{0};
+        std::atomic<std::uint64_t> after_ns{0};
+    };
+
+    // Chaîne d'une route, aplatie au démarrage en un tableau contigu de pointeurs de
+    // fonction : ni liste chaînée ni std::function à parcourir par requête. Une route sans
+    // middleware ne paie qu'un test sur empty().
+    class MiddlewarePipeline
+    {
+    public:
+        void append(const Middleware &middleware, MiddlewareStats &stats);
+        bool empty() const { return stages_.empty(); }
+        bool has_after() const { return has_after_; }
+
+        bool run_before(const http::request<http::string_body> &req, http::response<http::string_body> &res) const;
+        void run_after(const http::request<http::string_body> &req, http::response<http::string_body> &res) const;
+
+    private:
+        struct Stage
+        {
+            Middleware::Before before;
+            Middleware::After after;
+            MiddlewareStats *stats;
+        };
+
+        std::vector<Stage> stages_;
+        bool has_after_ = false;
+    };
+
+    // Filtre XSS (cible) et injection SQL (corps) ; 400 si la requête est suspecte.
+    Middleware waf_middleware();
+    // Pré-vol CORS : OPTIONS reçoit 204 et les en-têtes Access-Control-*.
+    Middleware cors_middleware();
+}
+
+#endif // MIDDLEWARE_HPP
@@ -0,0 +1,135 @@
+#ifndef ROUTEHANDLER_HPP
+#define ROUTEHANDLER_HPP
+
+#include "RouteParams.hpp"
+#include <boost/beast/http.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Handler d'une route, stocké dans la RouteEntry elle-même : un seul appel indirect,
+    // ni shared_ptr ni std::function. Tous les handlers suivent la même convention :
+    //   handler(req, params, res)
+    // params est vide pour une route statique. Une cible de plus de BUFFER_SIZE octets
+    // (ou dont le déplacement peut lever) est allouée à part, une fois à l'enregistrement.
+    class RouteHandler
+    {
+    public:
+        static constexpr std::size_t BUFFER_SIZE = 48;
+
+        using Request = http::request<http::string_body>;
+        using Response = http::response<http::string_body>;
+
+        RouteHandler() = default;
+
+        template <typename Handler, typename Target = std::decay_t<Handler>,
+                  typename = std::enable_if_t<!std::is_same_v<Target, RouteHandler>>>
+        RouteHandler(Handler &&handler)
+        {
+            static_assert(std::is_invocable_v<Target &, const Request &, const RouteParams &, Response &>,
+                          "route handler must be callable as handler(req, params, res)");
+            if constexpr (stored_inline<Target>())
+            {
+                ::new (static_cast<void *>(storage_)) Target(std::forward<Handler>(handler));
+                operations_ = &inline_operations<Target>;
+            }
+            else
+            {
+                ::new (static_cast<void *>(storage_)) Target *(new Target(std::forward<Handler>(handler)));
+                operations_ = &heap_operations<Target>;
+            }
+        }
+
+        RouteHandler(RouteHandler &&other) noexcept : operations_(other.operations_)
+        {
+            if (operations_)
+            {
+                operations_->move(other.storage_, storage_);
+                other.operations_ = nullptr;
+            }
+        }
+
+        RouteHandler &operator=(RouteHandler &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                operations_ = other.operations_;
+                if (operations_)
+                {
+                    operations_->move(other.storage_, storage_);
+                    other.operations_ = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        RouteHandler(const RouteHandler &) = delete;
+        RouteHandler &operator=(const RouteHandler &) = delete;
+
+        ~RouteHandler() { reset(); }
+
+        explicit operator bool() const { return operations_ != nullptr; }
+
+        // Comme std::function : l'appel est const, la cible ne l'est pas forcément.
+        void operator()(const Request &req, const RouteParams &params, Response &res) const
+        {
+            operations_->invoke(storage_, req, params, res);
+        }
+
+    private:
+        struct Operations
+        {
+            void (*invoke)(void *storage, const Request &, const RouteParams &, Response &);
+            void (*move)(void *from, void *to) noexcept;
+            void (*destroy)(void *storage) noexcept;
+        };
+
+        template <typename Target>
+        static constexpr bool stored_inline()
+        {
+            return sizeof(Target) <= BUFFER_SIZE && alignof(Target) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible_v<Target>;
+        }
+
+        template <typename Target>
+        static constexpr Operations inline_operations{
+            [](void *storage, const Request &req, const RouteParams &params, Response &res)
+            { (*static_cast<Target *>(storage))(req, params, res); },
+            [](void *from, void *to) noexcept
+            {
+                ::new (to) Target(std::move(*static_cast<Target *>(from)));
+                static_cast<Target *>(from)->~Target();
+            },
+            [](void *storage) noexcept
+            { static_cast<Target *>(storage)->~Target(); }};
+
+        template <typename Target>
+        static constexpr Operations heap_operations{
+            [](void *storage, const Request &req, const RouteParams &params, Response &res)
+            { (**static_cast<Target **>(storage))(req, params, res); },
+            [](void *from, void *to) noexcept
+            { ::new (to) Target *(*static_cast<Target **>(from)); },
+            [](void *storage) noexcept
+            { delete *static_cast<Target **>(storage); }};
+
+        void reset()
+        {
+            if (operations_)
+            {
+                operations_->destroy(storage_);
+                operations_ = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) mutable unsigned char storage_[BUFFER_SIZE];
+        const Operations *operations_ = nullptr;
+    };
+}
+
+#endif // ROUTEHANDLER_HPP
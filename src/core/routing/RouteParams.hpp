@@ -0,0 +1,63 @@
+#ifndef ROUTEPARAMS_HPP
+#define ROUTEPARAMS_HPP
+
+#include "RouteTree.hpp"
+#include "http/QueryString.hpp"
+#include <boost/beast/core/string.hpp>
+#include <string>
+#include <vector>
+
+namespace Softadastra
+{
+    // Paramètres d'une requête, vus sans copie : les noms viennent de la route, les valeurs
+    // sont des vues sur req.target() remplies par RouteTree, la query string est celle que
+    // le Router a séparée du chemin. L'objet vit sur la pile du Router le temps de l'appel
+    // au handler ; copier une valeur pour la garder au-delà.
+    class RouteParams
+    {
+    public:
+        RouteParams() = default;
+        RouteParams(const std::vector<std::string> &names, const RouteTree::Match &match, QueryString query)
+            : names_(&names), match_(&match), query_(query) {}
+
+        const QueryString &query() const { return query_; }
+
+        std::size_t size() const { return match_ ? match_->count : 0; }
+        bool empty() const { return size() == 0; }
+        boost::beast::string_view name(std::size_t index) const { return (*names_)[index]; }
+        boost::beast::string_view value(std::size_t index) const { return match_->values[index]; }
+
+        // Valeur du paramètre, ou nullptr s'il n'existe pas dans la route.
+        const boost::beast::string_view *find(boost::beast::string_view name) const
+        {
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                if (name == (*names_)[i])
+                {
+                    return &match_->values[i];
+                }
+            }
+            return nullptr;
+        }
+
+        bool contains(boost::beast::string_view name) const { return find(name) != nullptr; }
+
+        // std::out_of_range si la route n'a pas ce paramètre.
+        boost::beast::string_view at(boost::beast::string_view name) const
+        {
+            const boost::beast::string_view *value = find(name);
+            if (!value)
+            {
+                throw std::out_of_range("Missing route parameter: " + std::string(name));
+            }
+            return *value;
+        }
+
+    private:
+        const std::vector<std::string> *names_ = nullptr;
+        const RouteTree::Match *match_ = nullptr;
+        QueryString query_;
+    };
+}
+
+#endif // ROUTEPARAMS_HPP
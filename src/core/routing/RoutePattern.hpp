@@ -0,0 +1,153 @@
+#ifndef ROUTEPATTERN_HPP
+#define ROUTEPATTERN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace Softadastra
+{
+    // Type d'un paramètre de route, vérifié pendant la descente dans l'arbre : un segment
+    // refusé laisse sa chance au paramètre suivant du même nœud. L'ordre de l'énumération
+    // est l'ordre d'essai, du plus strict au plus large.
+    enum class ParamType : std::uint8_t
+    {
+        Integer, // {name:int}  : 1 à 18 chiffres, tient toujours dans un int64_t
+        Uuid,    // {name:uuid} : 8-4-4-4-12 chiffres hexadécimaux
+        Slug,    // {name:slug} : [A-Za-z0-9_-]+
+        Any      // {name}      : tout segment non vide ; {*name} : le reste du chemin
+    };
+
+    // Motif de route analysé par un constructeur constexpr :
+    //
+    //   static constexpr RoutePattern product{"/products/{id:int}/{slug:slug}"};
+    //
+    // Un motif mal formé déclaré constexpr ne compile pas ; construit à l'exécution (motif
+    // lu dans une chaîne), il lève std::invalid_argument.
+    class RoutePattern
+    {
+    public:
+        static constexpr std::size_t MAX_PARAMS = 8;
+
+        struct Param
+        {
+            std::string_view name{};
+            ParamType type = ParamType::Any;
+            bool wildcard = false;
+        };
+
+        constexpr explicit RoutePattern(std::string_view text) : text_(text)
+        {
+            std::size_t i = 0;
+            while (i < text.size())
+            {
+                if (text[i] == '}')
+                {
+                    throw std::invalid_argument("Route pattern: '}' without '{'");
+                }
+                if (text[i] != '{')
+                {
+                    ++i;
+                    continue;
+                }
+
+                const std::size_t close = text.find('}', i);
+                if (close == std::string_view::npos)
+                {
+                    throw std::invalid_argument("Route pattern: unterminated '{'");
+                }
+                Param param;
+                std::string_view spec = text.substr(i + 1, close - i - 1);
+                if (!spec.empty() && spec.front() == '*')
+                {
+                    param.wildcard = true;
+                    spec.remove_prefix(1);
+                }
+                const std::size_t colon = spec.find(':');
+                param.name = spec.substr(0, colon);
+                if (colon != std::string_view::npos)
+                {
+                    if (param.wildcard)
+                    {
+                        throw std::invalid_argument("Route pattern: a wildcard takes no type");
+                    }
+                    param.type = parse_type(spec.substr(colon + 1));
+                }
+                if (!valid_name(param.name))
+                {
+                    throw std::invalid_argument("Route pattern: parameter names are [A-Za-z0-9_]+");
+                }
+                for (std::size_t p = 0; p < count_; ++p)
+                {
+                    if (params_[p].name == param.name)
+                    {
+                        throw std::invalid_argument("Route pattern: duplicate parameter name");
+                    }
+                }
+                if (count_ == MAX_PARAMS)
+                {
+                    throw std::invalid_argument("Route pattern: too many parameters");
+                }
+
+                i = close + 1;
+                if (param.wildcard && i != text.size())
+                {
+                    throw std::invalid_argument("Route pattern: a wildcard must end the pattern");
+                }
+                // Un paramètre prend tout jusqu'au prochain '/' : rien ne peut le suivre
+                // dans le même segment.
+                if (i < text.size() && text[i] != '/')
+                {
+                    throw std::invalid_argument("Route pattern: a parameter must end its segment");
+                }
+                params_[count_++] = param;
+            }
+        }
+
+        constexpr std::string_view text() const { return text_; }
+        constexpr std::size_t param_count() const { return count_; }
+        constexpr const Param &param(std::size_t index) const { return params_[index]; }
+
+    private:
+        static constexpr ParamType parse_type(std::string_view type)
+        {
+            if (type == "int")
+            {
+                return ParamType::Integer;
+            }
+            if (type == "uuid")
+            {
+                return ParamType::Uuid;
+            }
+            if (type == "slug")
+            {
+                return ParamType::Slug;
+            }
+            throw std::invalid_argument("Route pattern: unknown parameter type (int, uuid, slug)");
+        }
+
+        static constexpr bool valid_name(std::string_view name)
+        {
+            if (name.empty())
+            {
+                return false;
+            }
+            for (char c : name)
+            {
+                if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::string_view text_;
+        std::array<Param, MAX_PARAMS> params_{};
+        std::size_t count_ = 0;
+    };
+}
+
+#endif // ROUTEPATTERN_HPP
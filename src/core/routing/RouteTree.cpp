@@ -0,0 +1,277 @@
+#include "RouteTree.hpp"
+#include <algorithm>
+
+namespace Softadastra
+{
+    namespace
+    {
+        bool accepts(ParamType type, boost::beast::string_view segment)
+        {
+            switch (type)
+            {
+            case ParamType::Integer:
+                return segment.size() <= 18 && std::all_of(segment.begin(), segment.end(), [](char c)
+                                                           { return c >= '0' && c <= '9'; });
+            case ParamType::Uuid:
+                if (segment.size() != 36)
+                {
+                    return false;
+                }
+                for (std::size_t i = 0; i < segment.size(); ++i)
+                {
+                    const char c = segment[i];
+                    const bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+                    const bool hex = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+                    if (dash ? c != '-' : !hex)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            case ParamType::Slug:
+                return std::all_of(segment.begin(), segment.end(), [](char c)
+                                   { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                                            c == '_' || c == '-'; });
+            case ParamType::Any:
+                break;
+            }
+            return true;
+        }
+    }
+
+    std::uint64_t RouteTree::method_bit(http::verb method)
+    {
+        const auto index = static_cast<unsigned>(method);
+        return index < 64 ? std::uint64_t(1) << index : 0;
+    }
+
+    std::string RouteTree::allow_header(std::uint64_t methods)
+    {
+        std::string allow;
+        for (unsigned index = 1; index < 64; ++index)
+        {
+            if (methods & (std::uint64_t(1) << index))
+            {
+                if (!allow.empty())
+                {
+                    allow += ", ";
+                }
+                const auto name = http::to_string(static_cast<http::verb>(index));
+                allow.append(name.data(), name.size());
+            }
+        }
+        return allow;
+    }
+
+    std::uint32_t RouteTree::add_node(Kind kind, std::string text, ParamType type)
+    {
+        Node node;
+        node.kind = kind;
+        node.type = type;
+        node.text = std::move(text);
+        nodes_.push_back(std::move(node));
+        return static_cast<std::uint32_t>(nodes_.size() - 1);
+    }
+
+    void RouteTree::insert(const RoutePattern &pattern, http::verb method, std::uint32_t route)
+    {
+        if (nodes_.empty())
+        {
+            add_node(Kind::Static, std::string(), ParamType::Any); // racine
+        }
+
+        // Le motif a déjà été validé : il reste à découper le texte autour des paramètres.
+        const std::string_view text = pattern.text();
+        std::uint32_t node = 0;
+        std::size_t i = 0;
+        std::size_t param = 0;
+        while (i < text.size())
+        {
+            const std::size_t open = text.find('{', i);
+            if (open != i)
+            {
+                const std::size_t end = open == std::string_view::npos ? text.size() : open;
+                node = insert_static(node, boost::beast::string_view(text.data() + i, end - i));
+                i = end;
+                continue;
+            }
+
+            const RoutePattern::Param &spec = pattern.param(param++);
+            node = spec.wildcard ? insert_wildcard(node) : insert_param(node, spec.type);
+            i = text.find('}', open) + 1;
+        }
+
+        Node &target = nodes_[node];
+        for (auto &[registered, index] : target.routes)
+        {
+            if (registered == method)
+            {
+                index = route;
+                return;
+            }
+        }
+        target.routes.emplace_back(method, route);
+        target.methods |= method_bit(method);
+    }
+
+    std::uint32_t RouteTree::insert_static(std::uint32_t node, boost::beast::string_view text)
+    {
+        // Indices plutôt que références : add_node() peut réallouer nodes_.
+        while (!text.empty())
+        {
+            const std::size_t slot = nodes_[node].first_chars.find(text.front());
+            if (slot == std::string::npos)
+            {
+                const std::uint32_t child = add_node(Kind::Static, std::string(text), ParamType::Any);
+                nodes_[node].first_chars.push_back(text.front());
+                nodes_[node].statics.push_back(child);
+                return child;
+            }
+
+            const std::uint32_t child = nodes_[node].statics[slot];
+            const std::string &prefix = nodes_[child].text;
+            std::size_t common = 0;
+            while (common < prefix.size() && common < text.size() && prefix[common] == text[common])
+            {
+                ++common;
+            }
+
+            if (common < prefix.size())
+            {
+                // Découpe : un nœud intermédiaire reprend le préfixe commun.
+                const std::uint32_t middle = add_node(Kind::Static, prefix.substr(0, common), ParamType::Any);
+                nodes_[child].text.erase(0, common);
+                nodes_[middle].first_chars.push_back(nodes_[child].text.front());
+                nodes_[middle].statics.push_back(child);
+                nodes_[node].statics[slot] = middle;
+                node = middle;
+            }
+            else
+            {
+                node = child;
+            }
+            text.remove_prefix(common);
+        }
+        return node;
+    }
+
+    std::uint32_t RouteTree::insert_param(std::uint32_t node, ParamType type)
+    {
+        // Un nœud par contrainte : le nom n'intervient pas dans la recherche, il est
+        // gardé par la route ("/a/{x}" et "/a/{y}" partagent le même nœud).
+        for (std::uint32_t child : nodes_[node].params)
+        {
+            if (nodes_[child].type == type)
+            {
+                return child;
+            }
+        }
+        const std::uint32_t child = add_node(Kind::Param, std::string(), type);
+        std::vector<std::uint32_t> &params = nodes_[node].params;
+        params.insert(std::find_if(params.begin(), params.end(), [&](std::uint32_t other)
+                                   { return nodes_[other].type > type; }),
+                      child);
+        return child;
+    }
+
+    std::uint32_t RouteTree::insert_wildcard(std::uint32_t node)
+    {
+        if (nodes_[node].wildcard == NONE)
+        {
+            const std::uint32_t child = add_node(Kind::Wildcard, std::string(), ParamType::Any);
+            nodes_[node].wildcard = child;
+        }
+        return nodes_[node].wildcard;
+    }
+
+    bool RouteTree::find(boost::beast::string_view path, http::verb method, Match &match) const
+    {
+        match.route = NONE;
+        match.allowed = 0;
+        match.fallback = NONE;
+        match.count = 0;
+        return !nodes_.empty() && walk(0, path, method, method_bit(method), match);
+    }
+
+    bool RouteTree::accept(const Node &node, http::verb method, std::uint64_t bit, Match &match) const
+    {
+        match.allowed |= node.methods;
+        if (match.fallback == NONE && !node.routes.empty())
+        {
+            match.fallback = node.routes.front().second;
+        }
+        if (!(node.methods & bit))
+        {
+            return false;
+        }
+        for (const auto &[registered, route] : node.routes)
+        {
+            if (registered == method)
+            {
+                match.route = route;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool RouteTree::walk(std::uint32_t index, boost::beast::string_view rest, http::verb method, std::uint64_t bit,
+                         Match &match) const
+    {
+        const Node &node = nodes_[index];
+        if (rest.empty())
+        {
+            if (accept(node, method, bit, match))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            // Au plus un enfant statique commence par ce caractère.
+            const std::size_t slot = node.first_chars.find(rest.front());
+            if (slot != std::string::npos)
+            {
+                const std::uint32_t child = node.statics[slot];
+                const std::string &prefix = nodes_[child].text;
+                if (rest.starts_with(boost::beast::string_view(prefix)) &&
+                    walk(child, rest.substr(prefix.size()), method, bit, match))
+                {
+                    return true;
+                }
+            }
+
+            if (!node.params.empty() && match.count < MAX_PARAMS)
+            {
+                const boost::beast::string_view segment = rest.substr(0, rest.find('/'));
+                if (!segment.empty())
+                {
+                    for (std::uint32_t child : node.params)
+                    {
+                        if (!accepts(nodes_[child].type, segment))
+                        {
+                            continue;
+                        }
+                        match.values[match.count++] = segment;
+                        if (walk(child, rest.substr(segment.size()), method, bit, match))
+                        {
+                            return true;
+                        }
+                        --match.count;
+                    }
+                }
+            }
+        }
+
+        if (node.wildcard != NONE && match.count < MAX_PARAMS)
+        {
+            match.values[match.count++] = rest;
+            if (accept(nodes_[node.wildcard], method, bit, match))
+            {
+                return true;
+            }
+            --match.count;
+        }
+        return false;
+    }
+}
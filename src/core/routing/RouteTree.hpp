@@ -0,0 +1,89 @@
+#ifndef ROUTETREE_HPP
+#define ROUTETREE_HPP
+
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "RoutePattern.hpp"
+
+namespace Softadastra
+{
+    namespace http = boost::beast::http;
+
+    // Arbre radix compressé des routes. Un motif (RoutePattern) mêle du texte statique
+    // (préfixes partagés entre routes), des paramètres typés qui prennent la fin du
+    // segment, et un joker final "{*name}" qui prend le reste du chemin.
+    //
+    // Une recherche est une seule descente sur le chemin, sans allocation ni regex : le
+    // texte statique est essayé d'abord, puis les paramètres, puis le joker. Chaque nœud
+    // terminal porte le masque des méthodes enregistrées, ce qui distingue 404 et 405
+    // pendant la même descente.
+    class RouteTree
+    {
+    public:
+        static constexpr std::size_t MAX_PARAMS = RoutePattern::MAX_PARAMS;
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+
+        struct Match
+        {
+            std::uint32_t route = NONE;
+            std::uint64_t allowed = 0; // méthodes des motifs qui couvrent le chemin (405, Allow)
+            std::uint32_t fallback = NONE; // une route du chemin, quelle que soit sa méthode (OPTIONS)
+            std::array<boost::beast::string_view, MAX_PARAMS> values{}; // dans l'ordre du motif
+            std::size_t count = 0;
+
+            // Valeurs reportées de from (chemin cherché) sur to, copie du même texte.
+            void rebase(boost::beast::string_view from, boost::beast::string_view to)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    values[i] = boost::beast::string_view(to.data() + (values[i].data() - from.data()), values[i].size());
+                }
+            }
+        };
+
+        // route : indice choisi par l'appelant, qui remplace celui déjà enregistré pour
+        // (motif, méthode). Les valeurs d'un Match suivent l'ordre des paramètres du motif.
+        void insert(const RoutePattern &pattern, http::verb method, std::uint32_t route);
+        bool find(boost::beast::string_view path, http::verb method, Match &match) const;
+
+        static std::uint64_t method_bit(http::verb method);
+        static std::string allow_header(std::uint64_t methods); // "GET, PUT"
+
+    private:
+        enum class Kind : std::uint8_t
+        {
+            Static,
+            Param,
+            Wildcard
+        };
+
+        struct Node
+        {
+            Kind kind = Kind::Static;
+            ParamType type = ParamType::Any;
+            std::string text;        // texte statique (vide pour la racine, les paramètres et le joker)
+            std::string first_chars; // premier caractère de chaque enfant statique, même ordre que statics
+            std::vector<std::uint32_t> statics;
+            std::vector<std::uint32_t> params; // triés par ParamType
+            std::uint32_t wildcard = NONE;
+            std::uint64_t methods = 0;
+            std::vector<std::pair<http::verb, std::uint32_t>> routes;
+        };
+
+        std::uint32_t add_node(Kind kind, std::string text, ParamType type);
+        std::uint32_t insert_static(std::uint32_t node, boost::beast::string_view text);
+        std::uint32_t insert_param(std::uint32_t node, ParamType type);
+        std::uint32_t insert_wildcard(std::uint32_t node);
+        bool accept(const Node &node, http::verb method, std::uint64_t bit, Match &match) const;
+        bool walk(std::uint32_t index, boost::beast::string_view rest, http::verb method, std::uint64_t bit, Match &match) const;
+
+        std::vector<Node> nodes_;
+    };
+}
+
+#endif // ROUTETREE_HPP
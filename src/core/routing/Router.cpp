@@ -1,245 +1,270 @@
-#include "DynamicRequestHandler.hpp"
 #include "Router.hpp"
 #include "http/Response.hpp"
-#include <regex>
+#include "http/HttpDate.hpp"
+#include "logging/AsyncLog.hpp"
+#include <algorithm>
 
 namespace Softadastra
 {
+    Router::Router()
+        : table_(std::make_unique<const RouteTable>()), update_mutex_(), entries_(), registrations_(), middleware_(),
+          middleware_rules_(), sealed_(false), static_mounts_(), static_middleware_()
+    {
+    }
+
     Router::~Router() {}
 
-    void Router::add_route(http::verb method, const std::string &route, std::shared_ptr<IRequestHandler> handler)
+    void Router::add_route(http::verb method, const std::string &route, RouteHandler handler, ExecutionPolicy policy)
     {
-        routes_[{method, route}] = std::move(handler);
-        route_patterns_.push_back(route);
+        insert(method, RouteEntry{std::move(handler), policy, route, nullptr, {}, {}});
     }
 
-    bool Router::handle_request(const http::request<http::string_body> &req, http::response<http::string_body> &res)
+    void Router::add_prebuilt_route(http::verb method, const std::string &route, http::response<http::string_body> response)
     {
-        bool is_production = std::getenv("ENV") && std::string(std::getenv("ENV")) == "production";
+        auto prebuilt = std::make_shared<const PrebuiltResponse>(std::move(response));
+        // Handler utilisé seulement quand la session ne peut pas écrire le tampon tel quel.
+        RouteHandler handler = [prebuilt](const http::request<http::string_body> &, const RouteParams &,
+                                          http::response<http::string_body> &res)
+        {
+            res = prebuilt->response();
+            res.set(http::field::date, HttpDate::now());
+        };
+        insert(method, RouteEntry{std::move(handler), ExecutionPolicy::Inline, route, std::move(prebuilt), {}, {}});
+    }
 
-        if (!is_production)
+    void Router::insert(http::verb method, RouteEntry entry)
+    {
+        const RoutePattern pattern(entry.pattern); // std::invalid_argument si mal formé
+        for (std::size_t i = 0; i < pattern.param_count(); ++i)
         {
-            spdlog::info("Received {} request for path '{}'", req.method_string(), req.target());
+            entry.params.emplace_back(pattern.param(i).name);
         }
 
-        if (req.method() == http::verb::options)
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        entries_.push_back(std::move(entry));
+        RouteEntry &added = entries_.back();
+        for (const auto &[rule_pattern, name] : middleware_rules_)
         {
-            if (!is_production)
+            if (rule_pattern.empty() || rule_pattern == added.pattern)
             {
-                spdlog::info("Handling OPTIONS request for path '{}'", req.target());
+                auto registered = std::find_if(middleware_.begin(), middleware_.end(), [&](const RegisteredMiddleware &candidate)
+                                               { return candidate.middleware.name == name; });
+                added.middleware.append(registered->middleware, registered->stats);
             }
+        }
 
-            res.result(http::status::no_content);
-            res.set(http::field::access_control_allow_origin, "*");
-            res.set(http::field::access_control_allow_methods, "GET, POST, PUT, DELETE, PATCH, OPTIONS, HEAD");
-            res.set(http::field::access_control_allow_headers, "Content-Type, Authorization");
-            return true;
+        // Une route réenregistrée serveur démarré remplace la précédente ; l'ancienne entrée
+        // reste dans entries_ pour les requêtes qui la référencent encore.
+        auto existing = std::find_if(registrations_.begin(), registrations_.end(), [&](const Registration &registration)
+                                     { return registration.method == method && registration.entry->pattern == added.pattern; });
+        if (existing != registrations_.end())
+        {
+            if (!sealed_)
+            {
+                // Au démarrage, c'est une erreur de configuration : la dernière prendrait
+                // la place de l'autre sans bruit. L'entrée ajoutée n'est jamais publiée.
+                throw std::invalid_argument("Route already registered: " + std::string(http::to_string(method)) + " " +
+                                            added.pattern);
+            }
+            SOFTADASTRA_LOG(spdlog::level::warn, "Route {} {} replaced", http::to_string(method), added.pattern);
+            *existing = Registration{method, &added, true};
         }
+        else
+        {
+            registrations_.push_back(Registration{method, &added, true});
+        }
+        publish();
+    }
 
-        if (req.method() != http::verb::get && req.method() != http::verb::post && req.method() != http::verb::put &&
-            req.method() != http::verb::delete_ && req.method() != http::verb::patch && req.method() != http::verb::head)
+    bool Router::set_route_enabled(http::verb method, const std::string &pattern, bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        auto existing = std::find_if(registrations_.begin(), registrations_.end(), [&](const Registration &registration)
+                                     { return registration.method == method && registration.entry->pattern == pattern; });
+        if (existing == registrations_.end())
         {
-            spdlog::warn("Method '{}' is not allowed for path '{}'", req.method_string(), req.target());
-            res.result(http::status::method_not_allowed);
-            res.set(http::field::content_type, "application/json");
-            res.body() = json{{"message", "Method Not Allowed"}}.dump();
             return false;
         }
+        if (existing->enabled != enabled)
+        {
+            existing->enabled = enabled;
+            publish();
+        }
+        return true;
+    }
 
-        bool route_exists = false;
-        bool method_allowed = false;
-
-        for (const auto &[route_key, handler] : routes_)
+    void Router::publish()
+    {
+        // Table reconstruite en entier (O(routes), rare) puis échangée ; l'ancienne est
+        // libérée quand plus aucune recherche ne la lit.
+        auto table = std::make_unique<RouteTable>();
+        for (const Registration &registration : registrations_)
         {
-            if (route_key.second == std::string(req.target()))
+            if (registration.enabled)
             {
-                route_exists = true;
-                if (route_key.first == req.method())
-                {
-                    method_allowed = true;
-                    handler->handle_request(req, res);
-                    return true;
-                }
+                table->tree.insert(RoutePattern(registration.entry->pattern), registration.method,
+                                   static_cast<std::uint32_t>(table->entries.size()));
+                table->entries.push_back(registration.entry);
             }
         }
+        table_.publish(std::move(table));
+    }
 
-        bool matched = false;
-        for (auto &[route_key, handler] : routes_)
+    void Router::register_middleware(Middleware middleware)
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        if (sealed_)
+        {
+            throw std::logic_error("Middleware registered after server start: " + middleware.name);
+        }
+        for (const auto &registered : middleware_)
         {
-            if (route_key.first == req.method() && matches_dynamic_route(route_key.second, std::string(req.target()), handler, res, req))
+            if (registered.middleware.name == middleware.name)
             {
-                matched = true;
-                break;
+                throw std::invalid_argument("Middleware already registered: " + middleware.name);
             }
         }
+        middleware_.emplace_back();
+        middleware_.back().middleware = std::move(middleware);
+    }
 
-        if (matched)
+    void Router::use_middleware(const std::string &name, const std::string &pattern)
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        if (sealed_)
         {
-            return true;
+            // Les entrées sont publiées : les modifier ici courrait après run_before().
+            throw std::logic_error("Middleware " + name + " added after server start");
         }
-
-        if (route_exists && !method_allowed)
+        auto registered = std::find_if(middleware_.begin(), middleware_.end(), [&](const RegisteredMiddleware &candidate)
+                                       { return candidate.middleware.name == name; });
+        if (registered == middleware_.end())
         {
-            spdlog::warn("Method '{}' is not allowed for path '{}'", req.method_string(), req.target());
-            res.result(http::status::method_not_allowed);
-            res.set(http::field::content_type, "application/json");
-            res.body() = json{{"message", "Method Not Allowed"}}.dump();
-            return false;
+            throw std::invalid_argument("Unknown middleware: " + name);
         }
 
-        spdlog::warn("Route not found for method '{}' and path '{}'", req.method_string(), req.target());
-        res.result(http::status::not_found);
-        res.set(http::field::content_type, "application/json");
-        res.body() = json{{"message", "Route not found"}}.dump();
-        return false;
+        bool found = pattern.empty();
+        if (pattern.empty())
+        {
+            static_middleware_.append(registered->middleware, registered->stats);
+        }
+        for (RouteEntry &entry : entries_)
+        {
+            if (pattern.empty() || entry.pattern == pattern)
+            {
+                entry.middleware.append(registered->middleware, registered->stats);
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            throw std::invalid_argument("Middleware " + name + ": no route " + pattern);
+        }
+        middleware_rules_.emplace_back(pattern, name);
     }
 
-    bool Router::matches_dynamic_route(const std::string &route_pattern, const std::string &path,
-                                       std::shared_ptr<IRequestHandler> handler, http::response<http::string_body> &res,
-                                       const http::request<http::string_body> &req)
+    void Router::seal()
     {
-        std::string regex_pattern = convert_route_to_regex(route_pattern);
-        spdlog::info("Checking if path '{}' matches pattern '{}'", path, regex_pattern);
-        boost::regex dynamic_route(regex_pattern);
-        boost::smatch match;
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        sealed_ = true;
+    }
 
-        if (boost::regex_match(path, match, dynamic_route))
+    std::vector<std::pair<std::string, MiddlewareStats::Snapshot>> Router::middleware_stats() const
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        std::vector<std::pair<std::string, MiddlewareStats::Snapshot>> stats;
+        for (const auto &registered : middleware_)
         {
-            std::unordered_map<std::string, std::string> params;
-            spdlog::info("Extracted parameters:");
-
-            size_t param_count = 1;
-
-            for (size_t start = 0; (start = route_pattern.find('{', start)) != std::string::npos;)
-            {
-                size_t end = route_pattern.find('}', start);
-                if (end != std::string::npos)
-                {
-                    std::string param_name = route_pattern.substr(start + 1, end - start - 1);
-                    if (param_count < match.size())
-                    {
-                        params[param_name] = match[param_count].str();
-                        param_count++;
-                        spdlog::info("Extracted parameter: {} = {}", param_name, params[param_name]);
-                    }
-                    start = end + 1;
-                }
-            }
-
-            if (!validate_parameters(params, res))
-            {
-                return false;
-            }
+            stats.emplace_back(registered.middleware.name, registered.stats.snapshot());
+        }
+        return stats;
+    }
 
-            auto dynamic_handler = std::dynamic_pointer_cast<DynamicRequestHandler>(handler);
-            if (dynamic_handler)
-            {
-                dynamic_handler->set_params(params, res);
-                if (res.result() != http::status::ok)
-                {
-                    return false;
-                }
+    void Router::mount_static(std::shared_ptr<StaticFiles> files)
+    {
+        static_mounts_.push_back(std::move(files));
+    }
 
-                dynamic_handler->handle_request(req, res);
-                return true;
-            }
-            else
+    StaticFiles *Router::static_files(boost::beast::string_view target) const
+    {
+        for (const auto &files : static_mounts_)
+        {
+            if (files->matches(target))
             {
-                Response::error_response(res, http::status::internal_server_error, "Internal Server Error: Handler type mismatch");
-                return false;
+                return files.get();
             }
         }
-        return false;
+        return nullptr;
     }
 
-    std::string Router::map_to_string(const std::unordered_map<std::string, std::string> &map)
+    void Router::resolve(const http::request<http::string_body> &req, RouteLookup &lookup) const
     {
-        std::ostringstream oss;
-        oss << "{ ";
-        for (const auto &[key, value] : map)
+        // Routage sur le chemin seul ; la query string reste aux handlers. Lecture de la
+        // table limitée à la recherche : un handler lent ne retarde pas la publication
+        // d'une nouvelle table.
+        const auto table = table_.read();
+        lookup.entry = nullptr;
+        lookup.fallback = nullptr;
+        if (table->tree.find(split_target(req.target()).path, req.method(), lookup.match))
         {
-            oss << key << ": " << value << ", ";
+            lookup.entry = table->entries[lookup.match.route];
         }
-        std::string result = oss.str();
-        if (!map.empty())
+        else if (lookup.match.fallback != RouteTree::NONE)
         {
-            result.pop_back();
-            result.pop_back();
+            lookup.fallback = table->entries[lookup.match.fallback];
         }
-        result += " }";
-        return result;
     }
 
-    std::string Router::sanitize_input(const std::string &input)
+    bool Router::handle_request(const http::request<http::string_body> &req, http::response<http::string_body> &res) const
     {
-        std::string sanitized = input;
-        sanitized = std::regex_replace(sanitized, std::regex("<[^>]*>"), "");
-        return sanitized;
+        RouteLookup lookup;
+        resolve(req, lookup);
+        return dispatch(lookup, req, res);
     }
 
-    bool Router::validate_parameters(const std::unordered_map<std::string, std::string> &params, http::response<http::string_body> &res)
+    bool Router::dispatch(const RouteLookup &lookup, const http::request<http::string_body> &req,
+                          http::response<http::string_body> &res) const
     {
-        for (const auto &[key, value] : params)
+        const RouteTree::Match &match = lookup.match;
+        if (!lookup.entry)
         {
-            std::string sanitized_value = sanitize_input(value);
-
-            if (key == "id" && !std::regex_match(sanitized_value, std::regex("^[0-9]+$")))
+            // OPTIONS sur une route existante : ses middlewares répondent (pré-vol CORS),
+            // sinon 204 avec les méthodes acceptées.
+            if (lookup.fallback && req.method() == http::verb::options)
             {
-                Response::error_response(res, http::status::bad_request, "Invalid 'id' parameter. Must be a positive integer.");
-                return false;
+                res.result(http::status::no_content);
+                res.set(http::field::allow, RouteTree::allow_header(match.allowed | RouteTree::method_bit(http::verb::options)));
+                lookup.fallback->middleware.run_before(req, res);
+                return true;
             }
 
-            if (key == "slug" && !std::regex_match(sanitized_value, std::regex("^[a-zA-Z0-9_-]+$")))
+            // Le chemin existe pour d'autres méthodes : 405, décidé pendant la même descente.
+            if (match.allowed != 0)
             {
-                Response::error_response(res, http::status::bad_request, "Invalid 'slug' parameter. Must be alphanumeric, with dashes or underscores.");
+                SOFTADASTRA_LOG(spdlog::level::warn, "Method '{}' is not allowed for path '{}'", req.method_string(), req.target());
+                res.result(http::status::method_not_allowed);
+                res.set(http::field::allow, RouteTree::allow_header(match.allowed));
+                res.set(http::field::content_type, "application/json");
+                res.body() = json{{"message", "Method Not Allowed"}}.dump();
                 return false;
             }
+
+            SOFTADASTRA_LOG(spdlog::level::warn, "Route not found for method '{}' and path '{}'", req.method_string(), req.target());
+            res.result(http::status::not_found);
+            res.set(http::field::content_type, "application/json");
+            res.body() = json{{"message", "Route not found"}}.dump();
+            return false;
         }
 
-        return true;
-    }
+        // Un seul appel pour toutes les formes de handler. Paramètres en vue sur la pile :
+        // ni copie des valeurs ni état partagé entre requêtes.
+        const RouteEntry &entry = *lookup.entry;
+        entry.handler(req, RouteParams(entry.params, match, QueryString(split_target(req.target()).query)), res);
 
-    std::string Router::convert_route_to_regex(const std::string &route_pattern)
-    {
-        std::string regex = "^";
-        bool inside_placeholder = false;
-        std::string param_name;
-
-        for (size_t i = 0; i < route_pattern.size(); ++i)
+        if (entry.middleware.has_after())
         {
-            char c = route_pattern[i];
-            if (c == '{')
-            {
-                inside_placeholder = true;
-                param_name.clear();
-                regex += "(";
-            }
-            else if (c == '}')
-            {
-                inside_placeholder = false;
-                regex += "[^/]+)";
-            }
-            else
-            {
-                if (inside_placeholder)
-                {
-                    param_name += c;
-                }
-                else
-                {
-                    if (c == '/')
-                    {
-                        regex += "\\/";
-                    }
-                    else
-                    {
-                        regex += c;
-                    }
-                }
-            }
+            entry.middleware.run_after(req, res);
         }
-        regex += "$";
-        return regex;
+        return true;
     }
-
 }
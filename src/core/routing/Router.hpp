@@ -6,7 +6,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <nlohmann/json.hpp>
 
-#include <boost/regex.hpp>
+#include <deque>
 #include <string>
 
 #include <unordered_map>
@@ -14,7 +14,14 @@
 #include <memory>
 #include <string>
 #include <spdlog/spdlog.h>
-#include "IRequestHandler.hpp"
+#include "RouteHandler.hpp"
+#include "ExecutionPolicy.hpp"
+#include "RouteTree.hpp"
+#include "TypedRequestHandler.hpp"
+#include "Middleware.hpp"
+#include "threading/Rcu.hpp"
+#include "http/StaticFiles.hpp"
+#include "http/PrebuiltResponse.hpp"
 #include "config/Config.hpp"
 
 namespace Softadastra
@@ -28,36 +35,122 @@ namespace Softadastra
     using ssl_socket = boost::asio::ssl::stream<tcp::socket>;
     using json = nlohmann::json;
 
-    struct PairHash
+    struct RouteEntry
     {
-        template <typename T1, typename T2>
-        std::size_t operator()(const std::pair<T1, T2> &p) const
-        {
-            auto h1 = std::hash<T1>{}(p.first);
-            auto h2 = std::hash<T2>{}(p.second);
-            return h1 ^ (h2 << 1);
-        }
+        RouteHandler handler; // stocké dans l'entrée : appel direct, sans compteur de références
+        ExecutionPolicy policy = ExecutionPolicy::Inline;
+        std::string pattern; // tel qu'enregistré ("/users/{id:int}") : clé des statistiques par route
+        std::shared_ptr<const PrebuiltResponse> prebuilt; // réponse constante, écrite sans appeler le handler
+        std::vector<std::string> params; // noms des paramètres, dans l'ordre du motif
+        MiddlewarePipeline middleware; // before() appliqués par la session, after() par dispatch()
+    };
+
+    // Résultat d'une recherche, gardé avec la requête jusqu'à l'appel du handler : une
+    // seule descente dans l'arbre par requête.
+    struct RouteLookup
+    {
+        const RouteEntry *entry = nullptr;    // nullptr : 404, 405 ou OPTIONS sans route
+        const RouteEntry *fallback = nullptr; // une route du chemin, quelle que soit sa méthode
+        RouteTree::Match match;               // valeurs : vues sur req.target()
     };
 
     class Router
     {
     public:
-        using RouteKey = std::pair<http::verb, std::string>;
-
-        Router() : routes_(), route_patterns_() {}
+        Router();
         ~Router();
-        void add_route(http::verb method, const std::string &route, std::shared_ptr<IRequestHandler> handler);
+        // handler(req, params, res) ; voir SimpleRequestHandler, DynamicRequestHandler et
+        // UnifiedRequestHandler pour les autres formes.
+        void add_route(http::verb method, const std::string &route, RouteHandler handler,
+                       ExecutionPolicy policy = ExecutionPolicy::Inline);
+        // Motif vérifié à la compilation ; le handler reçoit les paramètres déjà convertis :
+        //   static constexpr RoutePattern by_id{"/products/{id:int}"};
+        //   router.add_typed_route<by_id>(http::verb::get, [](const auto &req, std::int64_t id, auto &res) {...});
+        template <const RoutePattern &Pattern, typename Handler>
+        void add_typed_route(http::verb method, Handler handler, ExecutionPolicy policy = ExecutionPolicy::Inline)
+        {
+            insert(method, RouteEntry{TypedRequestHandler<Pattern, Handler>(std::move(handler)), policy,
+                                      std::string(Pattern.text()), nullptr, {}, {}});
+        }
+        // Réponse constante (page d'accueil, health check) : sérialisée ici une fois, la
+        // session l'écrit ensuite directement depuis le tampon partagé.
+        void add_prebuilt_route(http::verb method, const std::string &route, http::response<http::string_body> response);
+        // Recherche de la route ; lookup.entry nullptr : aucune. Une entrée n'est jamais
+        // libérée avant le Router : le pointeur reste valide même si la route est retirée
+        // ensuite. Les valeurs de lookup.match pointent dans req.target().
+        void resolve(const http::request<http::string_body> &req, RouteLookup &lookup) const;
+        // Handler et after() de la route trouvée par resolve(), sans nouvelle recherche ;
+        // false pour un 404 ou un 405 (res préparée, Allow compris).
+        bool dispatch(const RouteLookup &lookup, const http::request<http::string_body> &req,
+                      http::response<http::string_body> &res) const;
+        // resolve() puis dispatch().
         bool handle_request(const http::request<http::string_body> &req,
-                            http::response<http::string_body> &res);
+                            http::response<http::string_body> &res) const;
+
+        // Les routes peuvent être ajoutées (add_route...) ou désactivées serveur démarré :
+        // chaque modification publie une nouvelle table, les lecteurs ne sont jamais bloqués.
+        // Avant seal(), une route (méthode, motif) déjà enregistrée lève
+        // std::invalid_argument (deux contrôleurs sur la même route) ; ensuite, elle
+        // remplace la précédente. false si aucune route (method, pattern) n'est enregistrée.
+        bool set_route_enabled(http::verb method, const std::string &pattern, bool enabled);
+
+        // Middlewares composés au démarrage, une fois toutes les routes enregistrées :
+        // use_middleware() ajoute name à la chaîne des routes de motif pattern (toutes si
+        // vide, et alors aussi les répertoires statiques), dans l'ordre des appels.
+        // std::invalid_argument si le nom ou le motif est inconnu. Les chaînes des routes
+        // publiées sont lues sans verrou : seal(), appelé avant d'accepter des connexions,
+        // les fige, et les deux appels lèvent std::logic_error ensuite. Une route ajoutée
+        // plus tard reçoit sa chaîne selon les mêmes règles avant d'être publiée.
+        void register_middleware(Middleware middleware);
+        void use_middleware(const std::string &name, const std::string &pattern = std::string());
+        // Fin du démarrage (voir set_route_enabled et use_middleware).
+        void seal();
+        std::vector<std::pair<std::string, MiddlewareStats::Snapshot>> middleware_stats() const;
+
+        // Répertoire servi tel quel sous son préfixe, avant les routes ; la session
+        // envoie le corps par sendfile.
+        void mount_static(std::shared_ptr<StaticFiles> files);
+        StaticFiles *static_files(boost::beast::string_view target) const;
+        // Chaîne globale (use_middleware sans motif), appliquée aussi aux fichiers
+        // statiques ; after() n'y modifie que les en-têtes, le corps part par sendfile.
+        const MiddlewarePipeline &static_middleware() const { return static_middleware_; }
+        const std::vector<std::shared_ptr<StaticFiles>> &static_mounts() const { return static_mounts_; }
 
     private:
-        bool matches_dynamic_route(const std::string &route_pattern, const std::string &path, std::shared_ptr<IRequestHandler> handler, http::response<http::string_body> &res, const http::request<http::string_body> &req);
-        static std::string convert_route_to_regex(const std::string &route_pattern);
-        std::string sanitize_input(const std::string &input);
-        bool validate_parameters(const std::unordered_map<std::string, std::string> &params, http::response<http::string_body> &res);
-        std::unordered_map<RouteKey, std::shared_ptr<IRequestHandler>, PairHash> routes_;
-        std::string map_to_string(const std::unordered_map<std::string, std::string> &map);
-        std::vector<std::string> route_patterns_;
+        // Table publiée : immuable, remplacée en bloc à chaque modification.
+        struct RouteTable
+        {
+            RouteTree tree;
+            std::vector<const RouteEntry *> entries; // indice de l'arbre -> entrée
+        };
+
+        struct Registration
+        {
+            http::verb method;
+            RouteEntry *entry;
+            bool enabled;
+        };
+
+        struct RegisteredMiddleware
+        {
+            Middleware middleware;
+            MiddlewareStats stats;
+        };
+
+        void insert(http::verb method, RouteEntry entry);
+        void publish();
+
+        RcuPointer<RouteTable> table_;
+
+        // Côté écrivains, sous update_mutex_.
+        mutable std::mutex update_mutex_;
+        std::deque<RouteEntry> entries_; // jamais réduite : les RouteEntry* donnés aux sessions restent valides
+        std::vector<Registration> registrations_;
+        std::deque<RegisteredMiddleware> middleware_; // deque : les pipelines pointent sur stats
+        std::vector<std::pair<std::string, std::string>> middleware_rules_; // (motif, vide : toutes ; nom)
+        bool sealed_;
+        std::vector<std::shared_ptr<StaticFiles>> static_mounts_;
+        MiddlewarePipeline static_middleware_; // figée par seal(), comme celles des routes
     };
 };
 
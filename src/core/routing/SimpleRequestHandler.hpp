@@ -1,21 +1,26 @@
 #ifndef SIMPLEREQUESTHANDLER_HPP
 #define SIMPLEREQUESTHANDLER_HPP
 
-#include <algorithm>
-#include "IRequestHandler.hpp"
+#include "RouteHandler.hpp"
+#include <utility>
 
 namespace Softadastra
 {
-    class SimpleRequestHandler : public IRequestHandler
+    // Handler qui ignore les paramètres : handler(req, res).
+    template <typename Handler>
+    class SimpleRequestHandler
     {
     public:
-        explicit SimpleRequestHandler(std::function<void(const http::request<http::string_body> &, http::response<http::string_body> &)> handler);
-        ~SimpleRequestHandler() {}
-        void handle_request(const http::request<http::string_body> &req,
-                            http::response<http::string_body> &res) override;
+        explicit SimpleRequestHandler(Handler handler) : handler_(std::move(handler)) {}
+
+        void operator()(const http::request<http::string_body> &req, const RouteParams &,
+                        http::response<http::string_body> &res)
+        {
+            handler_(req, res);
+        }
 
     private:
-        std::function<void(const http::request<http::string_body> &, http::response<http::string_body> &)> handler_;
+        Handler handler_;
     };
 };
 
@@ -0,0 +1,113 @@
+#ifndef TYPEDREQUESTHANDLER_HPP
+#define TYPEDREQUESTHANDLER_HPP
+
+#include "RouteHandler.hpp"
+#include "RoutePattern.hpp"
+#include <boost/beast/core/string.hpp>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Softadastra
+{
+    // {name:uuid}, décodé en 16 octets.
+    struct Uuid
+    {
+        std::array<std::uint8_t, 16> bytes{};
+    };
+
+    // Type C++ reçu par le handler pour chaque ParamType, et conversion depuis le segment.
+    // L'arbre a déjà vérifié le format : la conversion ne peut pas échouer.
+    template <ParamType Type>
+    struct ParamValue
+    {
+        using type = boost::beast::string_view; // Slug, Any : vue sur la cible de la requête
+
+        static type parse(boost::beast::string_view segment) { return segment; }
+    };
+
+    template <>
+    struct ParamValue<ParamType::Integer>
+    {
+        using type = std::int64_t;
+
+        static type parse(boost::beast::string_view segment)
+        {
+            type value = 0;
+            std::from_chars(segment.data(), segment.data() + segment.size(), value);
+            return value;
+        }
+    };
+
+    template <>
+    struct ParamValue<ParamType::Uuid>
+    {
+        using type = Uuid;
+
+        static type parse(boost::beast::string_view segment)
+        {
+            Uuid uuid;
+            std::size_t byte = 0;
+            for (std::size_t i = 0; i + 1 < segment.size(); ++i)
+            {
+                if (segment[i] == '-')
+                {
+                    continue;
+                }
+                uuid.bytes[byte++] = static_cast<std::uint8_t>(hex(segment[i]) << 4 | hex(segment[i + 1]));
+                ++i;
+            }
+            return uuid;
+        }
+
+    private:
+        static int hex(char c)
+        {
+            return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+        }
+    };
+
+    // Handler d'une route à paramètres typés. Les valeurs arrivent des RouteParams du
+    // Router, dans l'ordre du motif : handler(req, valeurs..., res).
+    template <const RoutePattern &Pattern, typename Handler>
+    class TypedRequestHandler
+    {
+    public:
+        explicit TypedRequestHandler(Handler handler) : handler_(std::move(handler))
+        {
+            static_assert(invocable(std::make_index_sequence<Pattern.param_count()>{}),
+                          "handler must be callable as handler(req, parameters..., res) with the pattern's types "
+                          "(int: std::int64_t, uuid: Uuid, slug and untyped: boost::beast::string_view)");
+        }
+
+        void operator()(const http::request<http::string_body> &req, const RouteParams &params,
+                        http::response<http::string_body> &res)
+        {
+            call(req, params, res, std::make_index_sequence<Pattern.param_count()>{});
+        }
+
+    private:
+        template <std::size_t Index>
+        using value_t = ParamValue<Pattern.param(Index).type>;
+
+        template <std::size_t... Index>
+        static constexpr bool invocable(std::index_sequence<Index...>)
+        {
+            return std::is_invocable_v<Handler &, const http::request<http::string_body> &,
+                                       typename value_t<Index>::type..., http::response<http::string_body> &>;
+        }
+
+        template <std::size_t... Index>
+        void call(const http::request<http::string_body> &req, const RouteParams &params,
+                  http::response<http::string_body> &res, std::index_sequence<Index...>)
+        {
+            handler_(req, value_t<Index>::parse(params.value(Index))..., res);
+        }
+
+        Handler handler_;
+    };
+}
+
+#endif // TYPEDREQUESTHANDLER_HPP
@@ -1,223 +1,1196 @@
 #include "Session.hpp"
 #include "http/Response.hpp"
+#include "http/HttpDate.hpp"
+#include "http/ETag.hpp"
+#include "logging/AsyncLog.hpp"
 #include <boost/beast/http.hpp>
 #include <boost/beast/core.hpp>
 #include <spdlog/spdlog.h>
-#include <regex>
+#include <array>
+#include <charconv>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
 
 namespace Softadastra
 {
+    namespace
+    {
+        // Écrit la ligne de statut et les en-têtes comme http::serializer, afin de
+        // pouvoir envoyer plusieurs réponses pipelinées en un seul write.
+        std::size_t append_header(std::string &out, const http::response<http::string_body> &res)
+        {
+            const std::size_t start = out.size();
+
+            char status[4];
+            auto [end, ec] = std::to_chars(status, status + sizeof(status), res.result_int());
+            (void)ec;
+
+            out.append(res.version() == 10 ? "HTTP/1.0 " : "HTTP/1.1 ");
+            out.append(status, end);
+            out.push_back(' ');
+            const auto reason = res.reason();
+            out.append(reason.data(), reason.size());
+            out.append("\r\n");
+
+            for (const auto &field : res)
+            {
+                const auto name = field.name_string();
+                const auto value = field.value();
+                out.append(name.data(), name.size());
+                out.append(": ");
+                out.append(value.data(), value.size());
+                out.append("\r\n");
+            }
+            out.append("\r\n");
 
-    Session::Session(tcp::socket socket, Router &router)
-        : socket_(std::move(socket)), router_(router), buffer_(), req_()
+            return out.size() - start;
+        }
+    }
+
+    Session::Session(net::io_context &io_context, SessionContext &context, TimingWheel &timers, UringLoop *uring)
+        : socket_(io_context), uring_(uring), native_fd_(-1), context_(context), timers_(timers), deadline_(Deadline::Read),
+          options_(context.options), buffer_(), parser_(), pipeline_(),
+          write_headers_(), write_buffers_(), requests_served_(0), write_count_(0), write_closes_(false),
+          tls_(), staging_(), staging_offset_(0), ktls_send_(false), file_(), file_offset_(0), handshake_start_(), write_in_progress_(false), closing_(false)
     {
-        socket_.set_option(tcp::no_delay(true));
     }
 
-    Session::~Session() {}
+    Session::~Session()
+    {
+        abandon_cache_fills();
+        timers_.cancel(*this);
+        if (native_fd_ >= 0)
+        {
+            ::close(native_fd_);
+        }
+    }
+
+    void Session::open(tcp::socket socket)
+    {
+        socket_ = std::move(socket);
+        boost::system::error_code ec;
+        socket_.set_option(tcp::no_delay(true), ec);
+        // OpenSSL et sendfile écrivent eux-mêmes sur le fd : la socket doit être non bloquante.
+        socket_.non_blocking(true, ec);
 
-    void Session::run()
+        if (context_.tls)
+        {
+            tls_.attach(context_.tls->native_handle(), socket_.native_handle());
+            handshake_start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    void Session::open(int native_fd)
     {
-        auto self = shared_from_this();
-        read_request();
+        // TCP_NODELAY est hérité de la socket d'écoute.
+        native_fd_ = native_fd;
     }
 
-    void Session::read_request()
+    void PipelinedRequest::reset(std::size_t max_body_capacity)
     {
-        if (!socket_.is_open())
+        std::string request_body = std::move(req.body());
+        std::string response_body = std::move(res.body());
+        *this = PipelinedRequest();
+        if (request_body.capacity() <= max_body_capacity)
         {
-            spdlog::error("Socket is not open, cannot read request!");
-            return;
+            request_body.clear();
+            req.body() = std::move(request_body);
+        }
+        if (response_body.capacity() <= max_body_capacity)
+        {
+            response_body.clear();
+            res.body() = std::move(response_body);
         }
+    }
 
-        auto self = shared_from_this();
-        buffer_.consume(buffer_.size());
+    PipelinedRequest &RequestPipeline::next()
+    {
+        std::unique_ptr<PipelinedRequest> &slot = slots_[(head_ + size_) % MAX_PIPELINE_DEPTH];
+        if (!slot)
+        {
+            slot = std::make_unique<PipelinedRequest>();
+        }
+        return *slot;
+    }
+
+    PipelinedRequest &RequestPipeline::emplace_back()
+    {
+        PipelinedRequest &exchange = next();
+        ++size_;
+        return exchange;
+    }
 
-        auto timer = std::make_shared<boost::asio::steady_timer>(socket_.get_executor());
-        timer->expires_after(std::chrono::seconds(20));
+    void RequestPipeline::pop_front()
+    {
+        front().reset(MAX_RETAINED_BODY_SIZE);
+        head_ = (head_ + 1) % MAX_PIPELINE_DEPTH;
+        if (--size_ == 0)
+        {
+            // Sans pipelining, une connexion n'utilise ainsi que le premier emplacement.
+            head_ = 0;
+        }
+    }
 
-        std::weak_ptr<boost::asio::steady_timer> weak_timer = timer;
-        timer->async_wait([this, self, weak_timer](boost::system::error_code ec)
-                          {
-            auto timer = weak_timer.lock();
-            if (!timer)
+    void RequestPipeline::clear()
+    {
+        while (!empty())
+        {
+            pop_front();
+        }
+    }
+
+    std::size_t RequestPipeline::retained_bytes() const
+    {
+        std::size_t bytes = 0;
+        for (const auto &slot : slots_)
+        {
+            if (slot)
             {
-               spdlog::info("Timer is no longer available.");
-                return;
+                bytes += sizeof(PipelinedRequest) + slot->req.body().capacity() + slot->res.body().capacity();
+            }
+        }
+        return bytes;
+    }
+
+    void Session::abandon_cache_fills()
+    {
+        // Premier calcul d'une clé jamais terminé (connexion fermée avant complete_request) :
+        // les requêtes qui l'attendent le refont elles-mêmes.
+        for (std::size_t i = 0; i < pipeline_.size(); ++i)
+        {
+            PipelinedRequest &exchange = pipeline_[i];
+            if (exchange.cache_policy)
+            {
+                context_.cache.abandon(exchange.cache_key);
+                exchange.cache_policy = nullptr;
             }
-    
-            if (!ec)
+        }
+    }
+
+    void Session::recycle(std::size_t max_buffer_size)
+    {
+        timers_.cancel(*this);
+
+        if (socket_.is_open())
+        {
+            boost::system::error_code ec;
+            socket_.close(ec);
+        }
+        if (native_fd_ >= 0)
+        {
+            ::close(native_fd_);
+            native_fd_ = -1;
+        }
+
+        buffer_.clear();
+        if (buffer_.capacity() > max_buffer_size)
+        {
+            buffer_.shrink_to_fit();
+        }
+        write_headers_.clear();
+        if (write_headers_.capacity() > max_buffer_size)
+        {
+            write_headers_.shrink_to_fit();
+        }
+        write_buffers_.clear();
+        tls_.reset();
+        staging_.clear();
+        if (staging_.capacity() > max_buffer_size)
+        {
+            staging_.shrink_to_fit();
+        }
+        staging_offset_ = 0;
+        ktls_send_ = false;
+        file_.reset();
+        file_offset_ = 0;
+        parser_.reset();
+        abandon_cache_fills();
+        pipeline_.clear();
+
+        deadline_ = Deadline::Read;
+        requests_served_ = 0;
+        write_count_ = 0;
+        write_closes_ = false;
+        write_in_progress_ = false;
+        closing_ = false;
+    }
+
+    std::size_t Session::retained_bytes() const
+    {
+        return sizeof(Session) + buffer_.capacity() + write_headers_.capacity() + staging_.capacity() +
+               write_buffers_.capacity() * sizeof(net::const_buffer) + pipeline_.retained_bytes();
+    }
+
+    void Session::run()
+    {
+        if (tls_.active())
+        {
+            // Le handshake compte dans le délai de la première requête.
+            arm_deadline(Deadline::Read);
+            tls_handshake();
+            return;
+        }
+        read_request();
+    }
+
+    template <typename Handler>
+    void Session::wait_tls(TlsStream::Status status, Handler handler)
+    {
+        socket_.async_wait(status == TlsStream::Status::WantWrite ? tcp::socket::wait_write : tcp::socket::wait_read,
+                           [self = shared_from_this(), handler = std::move(handler)](boost::system::error_code ec) mutable
+                           { handler(ec); });
+    }
+
+    void Session::tls_handshake()
+    {
+        const TlsStream::Status status = tls_.handshake();
+        switch (status)
+        {
+        case TlsStream::Status::Done:
+            context_.tls->record_handshake(tls_.resumed(), std::chrono::duration_cast<std::chrono::microseconds>(
+                                                                std::chrono::steady_clock::now() - handshake_start_));
+            if (context_.tls->ktls_enabled())
             {
-                spdlog::warn("Timeout: No request received after 5 seconds!");
-                close_socket();
-            } });
+                ktls_send_ = tls_.ktls_send();
+                context_.tls->record_ktls(ktls_send_);
+            }
+            read_request();
+            return;
+        case TlsStream::Status::WantRead:
+        case TlsStream::Status::WantWrite:
+            wait_tls(status, [this](boost::system::error_code ec)
+                     {
+                         if (ec)
+                         {
+                             context_.tls->record_handshake_failure();
+                             close_socket();
+                             return;
+                         }
+                         tls_handshake(); });
+            return;
+        case TlsStream::Status::Closed:
+        case TlsStream::Status::Error:
+            timers_.cancel(*this);
+            context_.tls->record_handshake_failure();
+            SOFTADASTRA_LOG(spdlog::level::warn, "TLS handshake failed: {}", tls_.error().message());
+            close_socket();
+            return;
+        }
+    }
 
-        http::async_read(socket_, buffer_, req_,
-                         [this, self, timer](boost::system::error_code ec, std::size_t)
+    void Session::tls_read()
+    {
+        const net::mutable_buffer buffer = buffer_.prepare(READ_CHUNK_SIZE);
+        std::size_t transferred = 0;
+        const TlsStream::Status status = tls_.read(buffer.data(), buffer.size(), transferred);
+        switch (status)
+        {
+        case TlsStream::Status::Done:
+            // Complétion différée, comme un async_read_some : pas de récursion sur un
+            // client qui envoie plus vite que nous ne répondons.
+            net::post(socket_.get_executor(), [this, self = shared_from_this(), transferred]()
+                      { on_read({}, transferred); });
+            return;
+        case TlsStream::Status::WantRead:
+        case TlsStream::Status::WantWrite:
+            wait_tls(status, [this](boost::system::error_code ec)
+                     {
+                         if (ec)
                          {
-                             timer->cancel();
+                             on_read(ec, 0);
+                             return;
+                         }
+                         tls_read(); });
+            return;
+        case TlsStream::Status::Closed:
+        case TlsStream::Status::Error:
+            on_read(tls_.error(), 0);
+            return;
+        }
+    }
 
+    void Session::tls_write()
+    {
+        while (staging_offset_ < staging_.size())
+        {
+            std::size_t transferred = 0;
+            const TlsStream::Status status = tls_.write(staging_.data() + staging_offset_, staging_.size() - staging_offset_, transferred);
+            switch (status)
+            {
+            case TlsStream::Status::Done:
+                staging_offset_ += transferred;
+                continue;
+            case TlsStream::Status::WantRead:
+            case TlsStream::Status::WantWrite:
+                wait_tls(status, [this](boost::system::error_code ec)
+                         {
                              if (ec)
                              {
-                                 if (ec == http::error::end_of_stream)
-                                 {
-                                     spdlog::info("Client closed the connection.");
-                                 }
-                                 else if (ec != boost::asio::error::operation_aborted)
-                                 {
-                                     spdlog::error("Error during async_read: {}", ec.message());
-                                 }
-                                 close_socket();
+                                 on_batch_written(ec);
                                  return;
                              }
+                             tls_write(); });
+                return;
+            case TlsStream::Status::Closed:
+            case TlsStream::Status::Error:
+                on_batch_written(tls_.error());
+                return;
+            }
+        }
 
-                             //  spdlog::info("Request read successfully ({} bytes)", bytes_transferred);
+        net::post(socket_.get_executor(), [this, self = shared_from_this()]()
+                  { on_batch_written({}); });
+    }
 
-                             if (req_[http::field::connection] != "close")
-                             {
-                                 http::response<http::string_body> res;
-                                 res.set(http::field::connection, "keep-alive");
-                             }
+    bool Session::is_open() const
+    {
+        return uring_ ? native_fd_ >= 0 : socket_.is_open();
+    }
 
-                             handle_request(ec);
-                         });
+    void Session::read_request()
+    {
+        if (!is_open())
+        {
+            SOFTADASTRA_LOG(spdlog::level::err, "Socket is not open, cannot read request!");
+            return;
+        }
+
+        auto self = shared_from_this();
+
+        // Première requête : read_timeout ; entre deux requêtes : keep_alive_timeout.
+        arm_deadline(requests_served_ == 0 ? Deadline::Read : Deadline::Idle);
+
+        if (tls_.active())
+        {
+            tls_read();
+            return;
+        }
+
+        if (uring_)
+        {
+            // Le noyau choisit un tampon de l'anneau ; buffer_ ne sert que de repli.
+            uring_->recv(*this, native_fd_, buffer_.prepare(READ_CHUNK_SIZE), std::move(self));
+            return;
+        }
+
+        socket_.async_read_some(buffer_.prepare(READ_CHUNK_SIZE),
+                                [this, self](boost::system::error_code ec, std::size_t bytes_transferred)
+                                { on_read(ec, bytes_transferred); });
     }
 
-    void Session::handle_request(const boost::system::error_code &ec)
+    void Session::on_recv(const boost::system::error_code &ec, const char *data, std::size_t size)
     {
+        if (!ec && data)
+        {
+            net::buffer_copy(buffer_.prepare(size), net::buffer(data, size));
+        }
+        on_read(ec, size);
+    }
+
+    void Session::on_read(boost::system::error_code ec, std::size_t bytes_transferred)
+    {
+        timers_.cancel(*this);
+
         if (ec)
         {
-            spdlog::error("Error handling request: {}", ec.message());
+            if (ec == net::error::eof)
+            {
+                SOFTADASTRA_LOG(spdlog::level::debug, "Client closed the connection.");
+            }
+            else if (ec != boost::asio::error::operation_aborted)
+            {
+                SOFTADASTRA_LOG(spdlog::level::err, "Error during async_read: {}", ec.message());
+            }
+            close_socket();
             return;
         }
 
-        if (!waf_check_request(req_))
+        buffer_.commit(bytes_transferred);
+        process_buffer();
+    }
+
+    void Session::process_buffer()
+    {
+        // Un client pipeliné envoie plusieurs requêtes d'un coup : on traite toutes
+        // celles qui sont complètes dans buffer_ avant de répondre en une seule écriture.
+        while (!closing_ && pipeline_.size() < MAX_PIPELINE_DEPTH && buffer_.size() > 0)
         {
-            spdlog::warn("Request blocked by WAF.");
-            send_error("Request blocked due to security policy");
+            beast::error_code ec;
+            if (!parse_request(ec))
+            {
+                if (ec)
+                {
+                    SOFTADASTRA_LOG(spdlog::level::warn, "Invalid request: {}", ec.message());
+                    pipeline_.emplace_back();
+                    PipelinedRequest &exchange = pipeline_.back();
+                    send_error(exchange.res, ec == http::error::body_limit ? "Request too large" : "Invalid request");
+                    exchange.keep_alive = false;
+                    closing_ = true;
+                    complete_request(exchange);
+                }
+                break;
+            }
+
+            handle_request(pipeline_.back());
+        }
+
+        if (!pipeline_.empty())
+        {
+            flush_responses();
             return;
         }
 
-        if (req_.body().size() > MAX_REQUEST_BODY_SIZE)
+        read_request();
+    }
+
+    bool Session::parse_request(beast::error_code &ec)
+    {
+        if (!parser_)
+        {
+            // Le corps est lu dans le tampon de l'emplacement qui recevra la requête.
+            http::request<http::string_body> req;
+            req.body() = std::move(pipeline_.next().req.body());
+            parser_.emplace(std::move(req));
+            parser_->eager(true);
+            parser_->body_limit(MAX_REQUEST_BODY_SIZE);
+        }
+
+        std::size_t consumed = parser_->put(buffer_.data(), ec);
+        buffer_.consume(consumed);
+
+        if (ec == http::error::need_more)
         {
-            spdlog::warn("Request too large: {} bytes", req_.body().size());
-            send_error("Request too large");
+            ec = {};
+            return false;
+        }
+        if (ec)
+        {
+            parser_.reset();
+            return false;
+        }
+        if (!parser_->is_done())
+        {
+            return false;
+        }
+
+        pipeline_.emplace_back();
+        PipelinedRequest &exchange = pipeline_.back();
+        exchange.req = parser_->release();
+        parser_.reset();
+
+        // keep_alive() applique les règles de Connection propres à la version :
+        // HTTP/1.1 persistant sauf "close", HTTP/1.0 fermé sauf "keep-alive".
+        ++requests_served_;
+        exchange.keep_alive = exchange.req.keep_alive() && requests_served_ < options_.max_keep_alive_requests;
+        if (!exchange.keep_alive)
+        {
+            // La connexion sera fermée après cette réponse : les octets suivants sont ignorés.
+            closing_ = true;
+        }
+        return true;
+    }
+
+    void Session::handle_request(PipelinedRequest &exchange)
+    {
+        const http::request<http::string_body> &req = exchange.req;
+        http::response<http::string_body> &res = exchange.res;
+
+        if (req.body().size() > MAX_REQUEST_BODY_SIZE)
+        {
+            SOFTADASTRA_LOG(spdlog::level::warn, "Request too large: {} bytes", req.body().size());
+            exchange.keep_alive = false;
+            closing_ = true;
+            send_error(res, "Request too large");
+        }
+        else if (StaticFiles *files = context_.router.static_files(req.target()))
+        {
+            // Pas de route, mais la chaîne globale (WAF...) s'applique comme aux autres.
+            const MiddlewarePipeline &middleware = context_.router.static_middleware();
+            if (middleware.empty() || middleware.run_before(req, res))
+            {
+                serve_static(*files, exchange);
+                if (middleware.has_after())
+                {
+                    middleware.run_after(req, res);
+                }
+            }
+        }
+        else
+        {
+            // Recherche unique : la route et ses paramètres restent dans exchange jusqu'au handler.
+            context_.router.resolve(req, exchange.route);
+            const RouteEntry *route = exchange.route.entry;
+            if (route && !route->middleware.empty() && !route->middleware.run_before(req, res))
+            {
+                // Réponse écrite par un middleware (WAF...) : ni cache ni handler.
+                complete_request(exchange);
+                return;
+            }
+            // Des after() à appliquer : la réponse constante passe par son handler.
+            if (route && route->prebuilt && !route->middleware.has_after())
+            {
+                // Tampons partagés, sans handler ni sérialisation.
+                serve_cached(exchange, route->prebuilt);
+                complete_request(exchange);
+                return;
+            }
+            if (route && lookup_cache(exchange))
+            {
+                return;
+            }
+            execute(exchange);
             return;
         }
 
-        http::response<http::string_body> res;
-        bool success = router_.handle_request(req_, res);
+        complete_request(exchange);
+    }
 
-        if (!success)
+    void Session::execute(PipelinedRequest &exchange)
+    {
+        switch (exchange.route.entry ? exchange.route.entry->policy : ExecutionPolicy::Inline)
+        {
+        case ExecutionPolicy::CpuPool:
+            offload_request(context_.cpu_pool, exchange);
+            return;
+        case ExecutionPolicy::Blocking:
+            offload_request(context_.blocking_pool, exchange);
+            return;
+        case ExecutionPolicy::Inline:
+            run_route(exchange);
+            complete_request(exchange);
+            return;
+        }
+    }
+
+    void Session::run_route(PipelinedRequest &exchange)
+    {
+        // Une exception du handler ne doit ni tuer le thread (io ou pool) ni laisser une
+        // entrée du cache en calcul : elle devient un 500, transmis par complete_request().
+        try
+        {
+            route_request(exchange);
+        }
+        catch (const std::exception &e)
+        {
+            SOFTADASTRA_LOG(spdlog::level::err, "Error handling request: {}", e.what());
+            exchange.res = {};
+            send_error(exchange.res, "Internal Server Error", http::status::internal_server_error);
+        }
+    }
+
+    void Session::serve_static(StaticFiles &files, PipelinedRequest &exchange)
+    {
+        // Sur le thread io : une entrée du cache ne coûte aucun appel système ici.
+        http::response<http::string_body> &res = exchange.res;
+        if (exchange.req.method() != http::verb::get && exchange.req.method() != http::verb::head)
+        {
+            Response::error_response(res, http::status::method_not_allowed, "Method Not Allowed");
+            res.set(http::field::allow, "GET, HEAD");
+            return;
+        }
+
+        switch (files.find(exchange.req.target(), exchange.req[http::field::accept_encoding], exchange.file))
+        {
+        case StaticFiles::Lookup::Found:
+            StaticFiles::prepare_response(*exchange.file, res);
+            if (StaticFiles::not_modified(*exchange.file, exchange.req))
+            {
+                make_not_modified(res);
+                exchange.file.reset();
+            }
+            return;
+        case StaticFiles::Lookup::NotFound:
+            Response::error_response(res, http::status::not_found, "File not found");
+            return;
+        case StaticFiles::Lookup::Invalid:
+            SOFTADASTRA_LOG(spdlog::level::warn, "Rejected static file path: {}", exchange.req.target());
+            send_error(res, "Invalid path");
+            return;
+        }
+    }
+
+    bool Session::lookup_cache(PipelinedRequest &exchange)
+    {
+        // true : réponse servie depuis le cache, ou attendue d'un calcul en cours.
+        ResponseCache &cache = context_.cache;
+        const ResponseCache::Policy *policy =
+            exchange.req.method() == http::verb::get ? cache.policy(exchange.route.entry->pattern) : nullptr;
+        if (!policy || !ResponseCache::make_key(exchange.req, *policy, exchange.cache_key))
+        {
+            return false;
+        }
+
+        for (;;)
+        {
+            ResponseCache::Lookup lookup = cache.lookup(exchange.cache_key);
+            switch (lookup.outcome)
+            {
+            case ResponseCache::Outcome::Hit:
+                serve_cached(exchange, std::move(lookup.response));
+                complete_request(exchange);
+                return true;
+            case ResponseCache::Outcome::Stale:
+                serve_cached(exchange, std::move(lookup.response));
+                complete_request(exchange);
+                refresh_cache(exchange, *policy);
+                return true;
+            case ResponseCache::Outcome::Fill:
+                // Le résultat sert aussi aux requêtes en attente : le handler ne doit pas
+                // répondre 304 à la place d'une réponse complète.
+                exchange.cache_policy = policy;
+                exchange.if_none_match = std::string(exchange.req[http::field::if_none_match]);
+                exchange.req.erase(http::field::if_none_match);
+                return false;
+            case ResponseCache::Outcome::Pending:
+            {
+                // Comme offload_request : exchange reste en place jusqu'à ce qu'il soit prêt.
+                auto self = shared_from_this();
+                if (cache.wait(exchange.cache_key, [this, self, &exchange](std::shared_ptr<const PrebuiltResponse> response)
+                               { net::post(socket_.get_executor(), [this, self, &exchange, response = std::move(response)]() mutable
+                                           {
+                                               if (response)
+                                               {
+                                                   serve_cached(exchange, std::move(response));
+                                                   complete_request(exchange);
+                                               }
+                                               else
+                                               {
+                                                   // Calcul abandonné : la requête est traitée sans le cache.
+                                                   execute(exchange);
+                                               }
+                                               flush_responses();
+                                           }); }))
+                {
+                    return true;
+                }
+                break; // calcul terminé entre-temps
+            }
+            }
+        }
+    }
+
+    void Session::serve_cached(PipelinedRequest &exchange, std::shared_ptr<const PrebuiltResponse> response)
+    {
+        const auto if_none_match = exchange.req[http::field::if_none_match];
+        if (!if_none_match.empty() && etag_matches(if_none_match, response->response()[http::field::etag]))
+        {
+            // En-têtes seuls : le corps partagé n'est pas recopié.
+            exchange.res.base() = response->response().base();
+            exchange.res.set(http::field::date, HttpDate::now());
+            make_not_modified(exchange.res);
+            return;
+        }
+        if (exchange.req.version() == 11)
+        {
+            exchange.prebuilt = std::move(response);
+            return;
+        }
+        exchange.res = response->response();
+        exchange.res.set(http::field::date, HttpDate::now());
+    }
+
+    void Session::refresh_cache(const PipelinedRequest &exchange, const ResponseCache::Policy &policy)
+    {
+        // La réponse périmée est déjà servie : recalcul dans un pool, détaché de la
+        // connexion (qui peut se fermer entre-temps).
+        SessionContext &context = context_;
+        if (!context.admission.try_enqueue_request())
+        {
+            context.cache.abandon(exchange.cache_key);
+            return;
+        }
+
+        // La route déjà trouvée accompagne la copie, ses paramètres reportés sur sa cible :
+        // exchange peut être libéré avant le recalcul.
+        auto req = std::make_shared<http::request<http::string_body>>(exchange.req);
+        RouteLookup route = exchange.route;
+        route.match.rebase(exchange.req.target(), req->target());
+        ThreadPool &pool = route.entry->policy == ExecutionPolicy::Blocking ? context.blocking_pool : context.cpu_pool;
+        pool.enqueue(1, [&context, &policy, req, route, key = exchange.cache_key]()
+                     {
+                         http::response<http::string_body> res;
+                         try
+                         {
+                             if (context.router.dispatch(route, *req, res))
+                             {
+                                 set_etag(*req, res);
+                                 context.compressor.compress(*req, res, route.entry->pattern);
+                             }
+                         }
+                         catch (const std::exception &e)
+                         {
+                             SOFTADASTRA_LOG(spdlog::level::err, "Error refreshing cached response: {}", e.what());
+                             res = {};
+                             res.result(http::status::internal_server_error);
+                         }
+                         context.admission.release_request();
+                         context.cache.fill(key, policy, res);
+                     });
+    }
+
+    void Session::route_request(PipelinedRequest &exchange)
+    {
+        http::response<http::string_body> &res = exchange.res;
+
+        if (!context_.router.dispatch(exchange.route, exchange.req, res))
         {
             if (res.result() == http::status::method_not_allowed)
             {
-                send_error("Method Not Allowed");
+                const std::string allow(res[http::field::allow]);
+                send_error(res, "Method Not Allowed", http::status::method_not_allowed);
+                res.set(http::field::allow, allow);
             }
             else if (res.result() == http::status::not_found)
             {
-                send_error("Route Not Found");
+                send_error(res, "Route Not Found", http::status::not_found);
             }
             else
             {
-                send_error("Invalid request");
+                send_error(res, "Invalid request");
             }
             return;
         }
 
-        send_response(res);
+        if (!exchange.route.entry)
+        {
+            return;
+        }
+        // Un 304 n'a rien à compresser.
+        if (set_etag(exchange.req, res) && etag_matches(exchange.req[http::field::if_none_match], res[http::field::etag]))
+        {
+            make_not_modified(res);
+            return;
+        }
+        // Sur le thread du handler : un pool sature avant les threads io.
+        context_.compressor.compress(exchange.req, res, exchange.route.entry->pattern);
     }
 
-    void Session::send_response(http::response<http::string_body> &res)
+    bool Session::set_etag(const http::request<http::string_body> &req, http::response<http::string_body> &res)
     {
-        if (!socket_.is_open())
+        // ETag du corps non compressé (ou fourni par le handler), avant la compression
+        // qui le suffixe de son encodage : même valeur au premier calcul et aux recalculs.
+        // false : pas un 200 à un GET ou HEAD, rien à valider.
+        const http::verb method = req.method();
+        if (res.result() != http::status::ok || (method != http::verb::get && method != http::verb::head))
+        {
+            return false;
+        }
+        if (res.find(http::field::etag) == res.end())
+        {
+            res.set(http::field::etag, etag_for(res.body()));
+        }
+        return true;
+    }
+
+    void Session::offload_request(ThreadPool &pool, PipelinedRequest &exchange)
+    {
+        // Le handler ne touche qu'à exchange (stable dans la deque tant qu'il n'est pas
+        // prêt) ; la suite (en-têtes, écriture) reprend sur l'exécuteur de la socket.
+        if (!context_.admission.try_enqueue_request())
+        {
+            // File des pools pleine : 503 immédiat depuis le thread io, sans toucher au pool.
+            SOFTADASTRA_LOG(spdlog::level::warn, "Request queue full, rejecting {} {}", exchange.req.method_string(), exchange.req.target());
+            http::response<http::string_body> &res = exchange.res;
+            res = {};
+            Response::error_response(res, http::status::service_unavailable, "Server overloaded, retry later");
+            res.set(http::field::retry_after, std::to_string(context_.admission.limits().retry_after.count()));
+            complete_request(exchange);
+            return;
+        }
+
+        auto self = shared_from_this();
+        pool.enqueue(1, [this, self, &exchange]()
+                     {
+                         run_route(exchange);
+                         context_.admission.release_request();
+
+                         net::post(socket_.get_executor(), [this, self, &exchange]()
+                                   {
+                                       complete_request(exchange);
+                                       flush_responses();
+                                   });
+                     });
+    }
+
+    void Session::complete_request(PipelinedRequest &exchange)
+    {
+        exchange.ready = true;
+        if (exchange.cache_policy)
+        {
+            // Premier calcul de la clé : la réponse (ou l'erreur) est aussi celle des
+            // requêtes qui l'attendaient, sauf si elle est propre à cette connexion
+            // (Set-Cookie, private) ; déjà sérialisée pour celle-ci.
+            auto response = context_.cache.fill(exchange.cache_key, *exchange.cache_policy, exchange.res);
+            exchange.cache_policy = nullptr;
+            if (!exchange.if_none_match.empty())
+            {
+                exchange.req.set(http::field::if_none_match, exchange.if_none_match);
+            }
+            serve_cached(exchange, std::move(response));
+        }
+        if (exchange.prebuilt)
+        {
+            return;
+        }
+        http::response<http::string_body> &res = exchange.res;
+        res.version(exchange.req.version());
+        res.keep_alive(exchange.keep_alive);
+        if (!exchange.file && res.result() != http::status::not_modified)
+        {
+            // Content-Length d'un fichier : posé par StaticFiles, le corps n'est pas dans res.
+            // Un 304 n'en a pas : il décrit la copie du client.
+            res.prepare_payload();
+        }
+    }
+
+    void Session::flush_responses()
+    {
+        if (write_in_progress_)
         {
-            spdlog::error("Socket is not open, cannot send response!");
             return;
         }
 
+        if (!is_open())
+        {
+            SOFTADASTRA_LOG(spdlog::level::err, "Socket is not open, cannot send response!");
+            return;
+        }
+
+        // Les réponses partent dans l'ordre des requêtes : seules celles prêtes en tête
+        // de pipeline_ sont regroupées, et rien n'est envoyé après une réponse "close".
+        std::array<std::size_t, MAX_PIPELINE_DEPTH> header_sizes{};
+        std::size_t count = 0;
+        bool close_after_write = false;
+        write_headers_.clear();
+        for (std::size_t i = 0; i < pipeline_.size(); ++i)
+        {
+            const PipelinedRequest &exchange = pipeline_[i];
+            if (!exchange.ready || count == header_sizes.size())
+            {
+                break;
+            }
+            header_sizes[count++] = exchange.prebuilt ? PrebuiltResponse::append_tail(write_headers_, exchange.keep_alive)
+                                                      : append_header(write_headers_, exchange.res);
+            if (!exchange.keep_alive)
+            {
+                close_after_write = true;
+                break;
+            }
+            if (exchange.file && exchange.req.method() != http::verb::head)
+            {
+                // Le fichier part après le lot, par sendfile : il le termine.
+                break;
+            }
+        }
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        write_buffers_.clear();
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const PipelinedRequest &exchange = pipeline_[i];
+            if (exchange.prebuilt)
+            {
+                write_buffers_.emplace_back(net::buffer(exchange.prebuilt->head()));
+            }
+            write_buffers_.emplace_back(write_headers_.data() + offset, header_sizes[i]);
+            offset += header_sizes[i];
+            if (exchange.req.method() == http::verb::head)
+            {
+                continue;
+            }
+            if (exchange.file)
+            {
+                file_ = exchange.file;
+                file_offset_ = 0;
+            }
+            else if (exchange.prebuilt)
+            {
+                write_buffers_.emplace_back(net::buffer(exchange.prebuilt->body()));
+            }
+            else if (!exchange.res.body().empty())
+            {
+                write_buffers_.emplace_back(net::buffer(exchange.res.body()));
+            }
+        }
+
         auto self = shared_from_this();
-        auto res_ptr = std::make_shared<http::response<http::string_body>>(std::move(res));
+        write_in_progress_ = true;
+        write_count_ = count;
+        write_closes_ = close_after_write;
+        arm_deadline(Deadline::Write);
 
-        http::async_write(socket_, *res_ptr,
-                          [this, self, res_ptr](boost::system::error_code ec, std::size_t)
-                          {
-                              if (ec)
-                              {
-                                  spdlog::error("Error sending response: {}", ec.message());
-                                  close_socket();
-                                  return;
-                              }
+        // kTLS : write() en clair sur la socket donne directement des enregistrements TLS,
+        // on garde l'écriture groupée sans recopie ; les lectures restent dans OpenSSL.
+        if (tls_.active() && !ktls_send_)
+        {
+            // Un seul tampon clair : des enregistrements TLS pleins plutôt qu'un par segment.
+            staging_.clear();
+            staging_offset_ = 0;
+            for (const net::const_buffer &buffer : write_buffers_)
+            {
+                staging_.append(static_cast<const char *>(buffer.data()), buffer.size());
+            }
+            tls_write();
+            return;
+        }
 
-                              spdlog::info("Response sent successfully.");
+        if (uring_)
+        {
+            // Dernière réponse : écriture et fermeture liées, le fd appartient au noyau.
+            const bool close_now = close_after_write && !file_;
+            const int fd = native_fd_;
+            if (close_now)
+            {
+                native_fd_ = -1;
+            }
+            uring_->write(*this, fd, write_buffers_, close_now, std::move(self));
+            return;
+        }
 
-                              net::post(socket_.get_executor(), [this, self]()
-                                        { close_socket(); });
-                          });
+        net::async_write(socket_, write_buffers_,
+                         [this, self](boost::system::error_code ec, std::size_t)
+                         {
+                             on_batch_written(ec);
+                         });
     }
 
-    void Session::send_error(const std::string &error_message)
+    void Session::on_write(const boost::system::error_code &ec, std::size_t)
     {
-        http::response<http::string_body> res;
-        Response::error_response(res, http::status::bad_request, error_message);
+        on_batch_written(ec);
+    }
 
-        send_response(res);
+    void Session::on_batch_written(boost::system::error_code ec)
+    {
+        if (!ec && file_ && file_offset_ < file_->size)
+        {
+            send_file();
+            return;
+        }
+        file_.reset();
+        on_written(ec, write_count_, write_closes_);
     }
 
-    void Session::close_socket()
+    void Session::send_file()
     {
-        if (!socket_.is_open())
+        // Chaque progrès relance le délai d'écriture : un gros fichier n'est limité que
+        // par la vitesse du client, pas par write_timeout au total.
+        arm_deadline(Deadline::Write);
+        const std::uint64_t remaining = file_->size - file_offset_;
+
+        if (uring_ || (tls_.active() && !ktls_send_))
         {
-            spdlog::warn("Socket already closed or not open.");
+            // Pas de sendfile possible (chiffrement en espace utilisateur, ou fd détenu par
+            // l'anneau) : copie par morceaux dans staging_.
+            staging_.resize(static_cast<std::size_t>(std::min<std::uint64_t>(remaining, FILE_CHUNK_SIZE)));
+            const ssize_t n = ::pread(file_->fd, staging_.data(), staging_.size(), static_cast<off_t>(file_offset_));
+            if (n <= 0)
+            {
+                on_batch_written(n == 0 ? net::error::eof : boost::system::error_code(errno, boost::system::system_category()));
+                return;
+            }
+            staging_.resize(static_cast<std::size_t>(n));
+            staging_offset_ = 0;
+            file_offset_ += static_cast<std::uint64_t>(n);
+
+            if (uring_)
+            {
+                const bool close_now = write_closes_ && file_offset_ == file_->size;
+                const int fd = native_fd_;
+                if (close_now)
+                {
+                    native_fd_ = -1;
+                }
+                write_buffers_.assign(1, net::buffer(staging_));
+                uring_->write(*this, fd, write_buffers_, close_now, shared_from_this());
+                return;
+            }
+            tls_write();
             return;
         }
 
-        boost::system::error_code ec;
+        // Socket en clair ou kTLS : le noyau copie directement du page cache vers la socket.
+        off_t offset = static_cast<off_t>(file_offset_);
+        while (file_offset_ < file_->size)
+        {
+            const ssize_t n = ::sendfile(socket_.native_handle(), file_->fd, &offset,
+                                         static_cast<std::size_t>(std::min<std::uint64_t>(file_->size - file_offset_, SENDFILE_CHUNK_SIZE)));
+            if (n > 0)
+            {
+                file_offset_ = static_cast<std::uint64_t>(offset);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                socket_.async_wait(tcp::socket::wait_write, [this, self = shared_from_this()](boost::system::error_code ec)
+                                   {
+                                       if (ec)
+                                       {
+                                           on_batch_written(ec);
+                                           return;
+                                       }
+                                       send_file(); });
+                return;
+            }
+            // n == 0 : fichier tronqué pendant l'envoi, Content-Length ne peut plus être tenu.
+            on_batch_written(n == 0 ? net::error::eof : boost::system::error_code(errno, boost::system::system_category()));
+            return;
+        }
 
-        socket_.shutdown(tcp::socket::shutdown_both, ec);
-        if (ec && ec != boost::asio::error::not_connected)
+        net::post(socket_.get_executor(), [this, self = shared_from_this()]()
+                  { on_batch_written({}); });
+    }
+
+    void Session::on_written(boost::system::error_code ec, std::size_t count, bool close_after_write)
+    {
+        write_in_progress_ = false;
+        timers_.cancel(*this);
+
+        if (ec)
         {
-            spdlog::warn("Error during socket shutdown: {}", ec.message());
+            SOFTADASTRA_LOG(spdlog::level::err, "Error sending response: {}", ec.message());
+            close_socket();
+            return;
         }
 
-        if (socket_.is_open())
+        AsyncLog &log = AsyncLog::instance();
+        for (std::size_t i = 0; i < count; ++i)
         {
-            socket_.close(ec);
-            if (ec)
+            // Journal d'accès échantillonné (logging.access_sample_rate).
+            if (log.sample_access())
             {
-                spdlog::warn("Error closing socket: {}", ec.message());
+                const PipelinedRequest &exchange = pipeline_.front();
+                const unsigned status = exchange.prebuilt ? exchange.prebuilt->response().result_int() : exchange.res.result_int();
+                log.log(spdlog::level::info, "{} {} {}", exchange.req.method_string(), exchange.req.target(), status);
             }
-            else
+            pipeline_.pop_front();
+        }
+
+        if (close_after_write)
+        {
+            if (is_open())
             {
-                spdlog::info("Socket closed.");
+                net::post(socket_.get_executor(), [this, self = shared_from_this()]()
+                          { close_socket(); });
             }
+            return;
         }
+
+        if (!pipeline_.empty())
+        {
+            flush_responses();
+            return;
+        }
+
+        process_buffer();
     }
 
-    bool Session::waf_check_request(const http::request<http::string_body> &req)
+    void Session::arm_deadline(Deadline deadline)
     {
-        std::regex xss_pattern(R"(<script.*?>.*?</script>)", std::regex::icase);
-        std::regex sql_pattern(R"((\bUNION\b|\bSELECT\b|\bINSERT\b|\bDELETE\b|\bUPDATE\b|\bDROP\b))", std::regex::icase);
+        std::chrono::seconds timeout = options_.read_timeout;
+        if (deadline == Deadline::Idle)
+        {
+            timeout = options_.keep_alive_timeout;
+        }
+        else if (deadline == Deadline::Write)
+        {
+            timeout = options_.write_timeout;
+        }
 
-        if (std::regex_search(req.target().to_string(), xss_pattern))
+        deadline_ = deadline;
+        timers_.arm(*this, timeout);
+    }
+
+    void Session::on_expire(std::uint64_t generation)
+    {
+        // Thread du tick : la session peut être en cours de destruction (bloquée dans
+        // cancel()), d'où weak_from_this() ; le traitement reprend sur son exécuteur.
+        if (auto self = weak_from_this().lock())
         {
-            spdlog::warn("Possible XSS attack detected in URL: {}", req.target());
-            return false;
+            net::post(socket_.get_executor(), [self, generation]()
+                      { self->on_deadline(generation); });
         }
+    }
 
-        if (std::regex_search(req.body(), sql_pattern))
+    void Session::on_deadline(std::uint64_t generation)
+    {
+        if (generation != this->generation() || armed())
         {
-            spdlog::warn("Possible SQL injection detected in body: {}", req.body());
-            return false;
+            // Réarmée entre l'expiration et ce handler : l'échéance n'est plus d'actualité.
+            return;
         }
 
-        if (req.body().size() > MAX_REQUEST_BODY_SIZE)
+        switch (deadline_)
         {
-            spdlog::warn("Request body too large: {} bytes", req.body().size());
-            return false;
+        case Deadline::Read:
+            SOFTADASTRA_LOG(spdlog::level::warn, "Timeout: No request received after {} seconds!", options_.read_timeout.count());
+            break;
+        case Deadline::Write:
+            SOFTADASTRA_LOG(spdlog::level::warn, "Timeout: response not sent after {} seconds!", options_.write_timeout.count());
+            break;
+        case Deadline::Idle:
+            break;
         }
 
-        return true;
+        close_socket();
+    }
+
+    void Session::send_error(http::response<http::string_body> &res, const std::string &error_message,
+                             http::status status)
+    {
+        res = {};
+        Response::error_response(res, status, error_message);
+    }
+
+    void Session::close_socket()
+    {
+        if (!is_open())
+        {
+            SOFTADASTRA_LOG(spdlog::level::warn, "Socket already closed or not open.");
+            return;
+        }
+
+        if (uring_)
+        {
+            // shutdown() réveille la lecture en attente dans l'anneau ; close part avec le lot suivant.
+            ::shutdown(native_fd_, SHUT_RDWR);
+            uring_->close(native_fd_);
+            native_fd_ = -1;
+            SOFTADASTRA_LOG(spdlog::level::debug, "Socket closed.");
+            return;
+        }
+
+        tls_.shutdown();
+
+        boost::system::error_code ec;
+
+        socket_.shutdown(tcp::socket::shutdown_both, ec);
+        if (ec && ec != boost::asio::error::not_connected)
+        {
+            SOFTADASTRA_LOG(spdlog::level::warn, "Error during socket shutdown: {}", ec.message());
+        }
+
+        if (socket_.is_open())
+        {
+            socket_.close(ec);
+            if (ec)
+            {
+                SOFTADASTRA_LOG(spdlog::level::warn, "Error closing socket: {}", ec.message());
+            }
+            else
+            {
+                SOFTADASTRA_LOG(spdlog::level::debug, "Socket closed.");
+            }
+        }
     }
 
 } // namespace Softadastra
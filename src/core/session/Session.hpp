@@ -6,8 +6,20 @@
 #include <boost/asio.hpp>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
+#include <array>
 #include <memory>
+#include <optional>
+#include <vector>
 #include "routing/Router.hpp"
+#include "threading/ThreadPool.hpp"
+#include "TimingWheel.hpp"
+#include "uring/UringLoop.hpp"
+#include "tls/TlsContext.hpp"
+#include "tls/TlsStream.hpp"
+#include "http/StaticFiles.hpp"
+#include "http/Compression.hpp"
+#include "http/ResponseCache.hpp"
+#include "http/AdmissionController.hpp"
 
 namespace Softadastra
 {
@@ -18,25 +30,170 @@ namespace Softadastra
     using json = nlohmann::json;
 
     constexpr size_t MAX_REQUEST_BODY_SIZE = 10 * 1024 * 1024;
-    class Session : public std::enable_shared_from_this<Session>
+    constexpr size_t MAX_PIPELINE_DEPTH = 32;  // requêtes analysées d'avance par connexion
+    constexpr size_t MAX_RETAINED_BODY_SIZE = 64 * 1024; // corps gardé par un emplacement de pipeline
+    constexpr size_t READ_CHUNK_SIZE = 8 * 1024;
+    constexpr size_t SENDFILE_CHUNK_SIZE = 1024 * 1024; // par appel, pour rendre la main au thread io
+    constexpr size_t FILE_CHUNK_SIZE = 64 * 1024;       // copie quand sendfile est impossible
+
+    // Limites d'une connexion persistante (HTTP/1.1 keep-alive).
+    struct SessionOptions
+    {
+        std::chrono::seconds read_timeout{20};        // attente de la première requête
+        std::chrono::seconds keep_alive_timeout{5};   // inactivité entre deux requêtes
+        std::chrono::seconds write_timeout{20};       // envoi d'un lot de réponses
+        std::size_t max_keep_alive_requests = 100;    // requêtes servies avant fermeture
+    };
+
+    // Ressources partagées par toutes les sessions d'un serveur.
+    struct SessionContext
+    {
+        Softadastra::Router &router;
+        ThreadPool &cpu_pool;
+        ThreadPool &blocking_pool;
+        AdmissionController &admission;
+        ResponseCompressor &compressor;
+        ResponseCache &cache;
+        TlsContext *tls; // nullptr : HTTP en clair
+        SessionOptions options;
+    };
+
+    // Une requête analysée et sa réponse, dans l'ordre d'arrivée sur la connexion.
+    struct PipelinedRequest
+    {
+        http::request<http::string_body> req;
+        http::response<http::string_body> res;
+        RouteLookup route;                      // route.entry nullptr : route inconnue, fichier statique ou erreur
+        std::shared_ptr<const StaticFile> file; // corps envoyé depuis le fichier (sendfile)
+        std::shared_ptr<const PrebuiltResponse> prebuilt; // réponse constante ou en cache : res n'est pas utilisée
+        const ResponseCache::Policy *cache_policy = nullptr; // réponse à transmettre au cache (fill)
+        std::string cache_key;
+        std::string if_none_match; // retiré de req pendant le calcul partagé, évalué après fill()
+        bool keep_alive = false;
+        bool ready = false;
+
+        // Remise à zéro pour la requête suivante ; les corps gardent leur tampon (jusqu'à
+        // max_body_capacity).
+        void reset(std::size_t max_body_capacity);
+    };
+
+    // File des requêtes d'une connexion, sur des emplacements gardés d'une requête à
+    // l'autre (et d'une connexion à l'autre avec la session) : ni allocation ni
+    // libération par requête. L'adresse d'un élément ne change pas tant qu'il est dans
+    // la file (offload, attente du cache).
+    class RequestPipeline
     {
     public:
-        explicit Session(tcp::socket socket, Softadastra::Router &router);
+        bool empty() const { return size_ == 0; }
+        std::size_t size() const { return size_; }
+        PipelinedRequest &operator[](std::size_t index) { return *slots_[(head_ + index) % MAX_PIPELINE_DEPTH]; }
+        const PipelinedRequest &operator[](std::size_t index) const { return *slots_[(head_ + index) % MAX_PIPELINE_DEPTH]; }
+        PipelinedRequest &front() { return (*this)[0]; }
+        PipelinedRequest &back() { return (*this)[size_ - 1]; }
+
+        // Emplacement de la prochaine requête, encore hors de la file (file non pleine).
+        PipelinedRequest &next();
+        PipelinedRequest &emplace_back();
+        void pop_front();
+        void clear();
+        std::size_t retained_bytes() const;
+
+    private:
+        std::array<std::unique_ptr<PipelinedRequest>, MAX_PIPELINE_DEPTH> slots_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+    };
+
+    class Session : public std::enable_shared_from_this<Session>,
+                    private TimingWheel::Timer,
+                    private UringLoop::Stream
+    {
+    public:
+        // uring non nul : les E/S passent par l'anneau du shard (backend "io_uring"), la
+        // connexion est alors un simple descripteur et socket_ ne sert que d'exécuteur.
+        Session(net::io_context &io_context, SessionContext &context, TimingWheel &timers, UringLoop *uring);
         ~Session();
         void run();
 
+        // Rattache une connexion acceptée : socket asio, ou fd accepté par io_uring.
+        void open(tcp::socket socket);
+        void open(int native_fd);
+
+        // Recyclage par SessionPool : ferme la connexion et remet l'état à zéro en gardant
+        // les tampons (libérés au-delà de max_buffer_size) ; open() rattache la suivante.
+        void recycle(std::size_t max_buffer_size);
+        std::size_t retained_bytes() const;
+
     private:
+        bool is_open() const;
         void read_request();
+        void on_read(boost::system::error_code ec, std::size_t bytes_transferred);
+        void on_written(boost::system::error_code ec, std::size_t count, bool close_after_write);
+        void on_batch_written(boost::system::error_code ec);
+        void send_file();
+        void on_recv(const boost::system::error_code &ec, const char *data, std::size_t size) override;
+        void on_write(const boost::system::error_code &ec, std::size_t size) override;
+
+        // TLS : handshake, lecture et écriture non bloquantes sur la socket, relancées
+        // quand elle redevient lisible ou inscriptible.
+        void tls_handshake();
+        void tls_read();
+        void tls_write();
+        template <typename Handler>
+        void wait_tls(TlsStream::Status status, Handler handler);
+        void process_buffer();
+        bool parse_request(beast::error_code &ec);
         void close_socket();
-        void handle_request(const boost::system::error_code &ec);
-        void send_response(http::response<http::string_body> &res);
-        bool waf_check_request(const boost::beast::http::request<boost::beast::http::string_body> &req);
-        void send_error(const std::string &error_message);
+        void handle_request(PipelinedRequest &exchange);
+        void serve_static(StaticFiles &files, PipelinedRequest &exchange);
+        bool lookup_cache(PipelinedRequest &exchange);
+        void serve_cached(PipelinedRequest &exchange, std::shared_ptr<const PrebuiltResponse> response);
+        void refresh_cache(const PipelinedRequest &exchange, const ResponseCache::Policy &policy);
+        void execute(PipelinedRequest &exchange);
+        void run_route(PipelinedRequest &exchange);
+        void route_request(PipelinedRequest &exchange);
+        static bool set_etag(const http::request<http::string_body> &req, http::response<http::string_body> &res);
+        void offload_request(ThreadPool &pool, PipelinedRequest &exchange);
+        void complete_request(PipelinedRequest &exchange);
+        void abandon_cache_fills();
+        void flush_responses();
+        void send_error(http::response<http::string_body> &res, const std::string &error_message,
+                        http::status status = http::status::bad_request);
+
+        enum class Deadline
+        {
+            Read,
+            Idle,
+            Write
+        };
+        void arm_deadline(Deadline deadline);
+        void on_expire(std::uint64_t generation) override;
+        void on_deadline(std::uint64_t generation);
 
         tcp::socket socket_;
-        Softadastra::Router &router_;
+        UringLoop *uring_;
+        int native_fd_;
+        SessionContext &context_;
+        TimingWheel &timers_;
+        Deadline deadline_;
+        const SessionOptions &options_;
         beast::flat_buffer buffer_;
-        http::request<http::string_body> req_;
+        std::optional<http::request_parser<http::string_body>> parser_;
+        RequestPipeline pipeline_;
+        std::string write_headers_;
+        std::vector<net::const_buffer> write_buffers_;
+        std::size_t requests_served_;
+        std::size_t write_count_; // réponses du lot en cours d'écriture
+        bool write_closes_;
+        TlsStream tls_;
+        std::string staging_; // copie claire : réponses regroupées avant chiffrement, morceau de fichier
+        std::size_t staging_offset_;
+        bool ktls_send_; // kTLS : le noyau chiffre, les réponses s'écrivent en clair sur la socket
+        std::shared_ptr<const StaticFile> file_; // fichier qui termine le lot en cours
+        std::uint64_t file_offset_;
+        std::chrono::steady_clock::time_point handshake_start_;
+        bool write_in_progress_;
+        bool closing_;
     };
 };
 
@@ -0,0 +1,141 @@
+#include "SessionPool.hpp"
+
+namespace Softadastra
+{
+    SessionPool::SessionPool(net::io_context &io_context, SessionContext &context, TimingWheel &timers, UringLoop *uring,
+                             std::size_t max_sessions, std::size_t max_retained_bytes)
+        : io_context_(io_context),
+          context_(context),
+          timers_(timers),
+          uring_(uring),
+          max_sessions_(max_sessions),
+          max_retained_bytes_(max_retained_bytes),
+          mutex_(),
+          free_(),
+          free_blocks_(),
+          block_size_(0),
+          retained_bytes_(0),
+          hits_(0),
+          misses_(0),
+          discarded_(0)
+    {
+        free_.reserve(max_sessions_);
+        free_blocks_.reserve(max_sessions_);
+    }
+
+    SessionPool::~SessionPool()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Session *session : free_)
+        {
+            delete session;
+        }
+        free_.clear();
+        for (void *block : free_blocks_)
+        {
+            ::operator delete(block);
+        }
+        free_blocks_.clear();
+    }
+
+    std::shared_ptr<Session> SessionPool::acquire(tcp::socket socket)
+    {
+        return acquire_session(std::move(socket));
+    }
+
+    std::shared_ptr<Session> SessionPool::acquire(int native_fd)
+    {
+        return acquire_session(native_fd);
+    }
+
+    template <typename Connection>
+    std::shared_ptr<Session> SessionPool::acquire_session(Connection connection)
+    {
+        Session *session = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty())
+            {
+                session = free_.back();
+                free_.pop_back();
+                retained_bytes_ -= session->retained_bytes();
+            }
+        }
+
+        if (session)
+        {
+            ++hits_;
+        }
+        else
+        {
+            ++misses_;
+            session = new Session(io_context_, context_, timers_, uring_);
+        }
+        session->open(std::move(connection));
+
+        return std::shared_ptr<Session>(
+            session, [this](Session *s)
+            { release(s); },
+            ControlBlockAllocator<Session>(*this));
+    }
+
+    void *SessionPool::allocate_block(std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (block_size_ == 0)
+            {
+                block_size_ = size;
+            }
+            if (size == block_size_ && !free_blocks_.empty())
+            {
+                void *block = free_blocks_.back();
+                free_blocks_.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void SessionPool::deallocate_block(void *block, std::size_t size)
+    {
+        // Après release() : le bloc est rendu une fois la session déjà remise en liste.
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (size == block_size_ && free_blocks_.size() < max_sessions_)
+            {
+                free_blocks_.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    void SessionPool::release(Session *session)
+    {
+        // Dernière référence relâchée : la connexion est terminée.
+        context_.admission.release_connection();
+
+        session->recycle(MAX_RECYCLED_BUFFER_SIZE);
+        const std::size_t bytes = session->retained_bytes();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_.size() < max_sessions_ && retained_bytes_ + bytes <= max_retained_bytes_)
+            {
+                free_.push_back(session);
+                retained_bytes_ += bytes;
+                return;
+            }
+        }
+
+        ++discarded_;
+        delete session;
+    }
+
+    SessionPool::Stats SessionPool::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Stats{hits_.load(), misses_.load(), discarded_.load(), free_.size(), retained_bytes_};
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef SESSIONPOOL_HPP
+#define SESSIONPOOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Session.hpp"
+
+namespace Softadastra
+{
+    // Au-delà de cette taille, les tampons d'une session sont libérés avant recyclage :
+    // une requête volumineuse ne doit pas immobiliser sa mémoire dans la liste libre.
+    constexpr std::size_t MAX_RECYCLED_BUFFER_SIZE = 64 * 1024;
+
+    // Liste libre de sessions propre à un shard. Une session terminée (dernier shared_ptr
+    // relâché) est réinitialisée et conservée avec ses tampons, au lieu d'être détruite.
+    // Le bloc de contrôle de chaque shared_ptr<Session> vient lui aussi d'une liste libre :
+    // une connexion ne coûte aucune allocation une fois le pool chaud.
+    class SessionPool
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t hits;      // session reprise de la liste libre
+            std::uint64_t misses;    // liste vide : nouvelle allocation
+            std::uint64_t discarded; // non conservée (plafond atteint)
+            std::size_t retained_sessions;
+            std::size_t retained_bytes;
+        };
+
+        SessionPool(net::io_context &io_context, SessionContext &context, TimingWheel &timers, UringLoop *uring,
+                    std::size_t max_sessions, std::size_t max_retained_bytes);
+        ~SessionPool();
+        SessionPool(const SessionPool &) = delete;
+        SessionPool &operator=(const SessionPool &) = delete;
+
+        std::shared_ptr<Session> acquire(tcp::socket socket);
+        std::shared_ptr<Session> acquire(int native_fd);
+        Stats stats() const;
+
+    private:
+        // Allocateur des blocs de contrôle, tous de la même taille.
+        template <typename T>
+        struct ControlBlockAllocator
+        {
+            using value_type = T;
+
+            explicit ControlBlockAllocator(SessionPool &owner) : pool(&owner) {}
+            template <typename U>
+            ControlBlockAllocator(const ControlBlockAllocator<U> &other) : pool(other.pool) {}
+
+            T *allocate(std::size_t n) { return static_cast<T *>(pool->allocate_block(n * sizeof(T))); }
+            void deallocate(T *block, std::size_t n) { pool->deallocate_block(block, n * sizeof(T)); }
+
+            template <typename U>
+            bool operator==(const ControlBlockAllocator<U> &other) const { return pool == other.pool; }
+            template <typename U>
+            bool operator!=(const ControlBlockAllocator<U> &other) const { return pool != other.pool; }
+
+            SessionPool *pool;
+        };
+
+        template <typename Connection>
+        std::shared_ptr<Session> acquire_session(Connection connection);
+        void release(Session *session);
+        void *allocate_block(std::size_t size);
+        void deallocate_block(void *block, std::size_t size);
+
+        net::io_context &io_context_;
+        SessionContext &context_;
+        TimingWheel &timers_;
+        UringLoop *uring_;
+        const std::size_t max_sessions_;
+        const std::size_t max_retained_bytes_;
+        // Le dernier shared_ptr peut être relâché sur un thread du pool bloquant.
+        mutable std::mutex mutex_;
+        std::vector<Session *> free_;
+        std::vector<void *> free_blocks_;
+        std::size_t block_size_; // 0 : aucun bloc alloué encore
+        std::size_t retained_bytes_;
+        std::atomic<std::uint64_t> hits_;
+        std::atomic<std::uint64_t> misses_;
+        std::atomic<std::uint64_t> discarded_;
+    };
+}
+
+#endif // SESSIONPOOL_HPP
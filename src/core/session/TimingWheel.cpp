@@ -0,0 +1,201 @@
+#include "TimingWheel.hpp"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace Softadastra
+{
+    TimingWheel::TimingWheel(net::io_context &io_context, std::chrono::milliseconds tick, std::size_t slots)
+        : tick_timer_(io_context),
+          tick_(tick),
+          next_tick_(),
+          slots_(slots + 1, nullptr),
+          mask_(slots - 1),
+          due_slot_(slots),
+          cursor_(0),
+          running_(false),
+          mutex_(),
+          fired_(),
+          firing_(nullptr),
+          firing_thread_()
+    {
+        if (slots == 0 || (slots & (slots - 1)) != 0)
+        {
+            throw std::invalid_argument("TimingWheel: slot count must be a power of two");
+        }
+        if (tick.count() <= 0)
+        {
+            throw std::invalid_argument("TimingWheel: tick must be positive");
+        }
+    }
+
+    TimingWheel::~TimingWheel()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Timer *&head : slots_)
+        {
+            while (head)
+            {
+                unlink(*head);
+            }
+        }
+    }
+
+    void TimingWheel::start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_)
+        {
+            return;
+        }
+        running_ = true;
+        next_tick_ = std::chrono::steady_clock::now() + tick_;
+        schedule_tick();
+    }
+
+    void TimingWheel::stop()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        tick_timer_.cancel();
+    }
+
+    void TimingWheel::arm(Timer &timer, std::chrono::milliseconds timeout)
+    {
+        // Arrondi au tick supérieur, plus un tick pour la case courante déjà entamée :
+        // une échéance expire entre timeout et timeout + tick, jamais en avance.
+        const std::size_t ticks = static_cast<std::size_t>((timeout + tick_ - std::chrono::milliseconds(1)) / tick_) + 1;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timer.wheel_)
+        {
+            unlink(timer);
+        }
+        timer.rounds_ = (ticks - 1) / due_slot_;
+        ++timer.generation_;
+        link(timer, (cursor_ + ticks) & mask_);
+    }
+
+    void TimingWheel::cancel(Timer &timer)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (firing_ == &timer && firing_thread_ != std::this_thread::get_id())
+        {
+            // on_expire() tourne sur le thread du tick : le Timer doit lui survivre.
+            fired_.wait(lock, [&]
+                        { return firing_ != &timer; });
+        }
+        if (timer.wheel_)
+        {
+            unlink(timer);
+        }
+    }
+
+    void TimingWheel::schedule_tick()
+    {
+        // Verrou tenu : stop() peut annuler tick_timer_ depuis un autre thread.
+        tick_timer_.expires_at(next_tick_);
+        tick_timer_.async_wait([this](boost::system::error_code ec)
+                               {
+                                   if (ec)
+                                   {
+                                       if (ec != net::error::operation_aborted)
+                                       {
+                                           spdlog::error("TimingWheel tick failed: {}", ec.message());
+                                       }
+                                       return;
+                                   }
+                                   on_tick(); });
+    }
+
+    void TimingWheel::on_tick()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_)
+            {
+                return;
+            }
+
+            // Si le thread a pris du retard, on rattrape toutes les cases écoulées.
+            const auto now = std::chrono::steady_clock::now();
+            while (next_tick_ <= now)
+            {
+                next_tick_ += tick_;
+                cursor_ = (cursor_ + 1) & mask_;
+
+                Timer *timer = slots_[cursor_];
+                while (timer)
+                {
+                    Timer *next = timer->next_;
+                    if (timer->rounds_ == 0)
+                    {
+                        unlink(*timer);
+                        link(*timer, due_slot_);
+                    }
+                    else
+                    {
+                        --timer->rounds_;
+                    }
+                    timer = next;
+                }
+            }
+        }
+        fire_due();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_)
+        {
+            schedule_tick();
+        }
+    }
+
+    void TimingWheel::fire_due()
+    {
+        // Une échéance annulée ou réarmée entre-temps a quitté la case : elle ne part pas.
+        std::unique_lock<std::mutex> lock(mutex_);
+        firing_thread_ = std::this_thread::get_id();
+        while (Timer *timer = slots_[due_slot_])
+        {
+            unlink(*timer);
+            firing_ = timer;
+            const std::uint64_t generation = timer->generation_;
+            lock.unlock();
+            timer->on_expire(generation);
+            lock.lock();
+            firing_ = nullptr;
+            fired_.notify_all();
+        }
+    }
+
+    void TimingWheel::link(Timer &timer, std::size_t slot)
+    {
+        timer.wheel_ = this;
+        timer.slot_ = slot;
+        timer.prev_ = nullptr;
+        timer.next_ = slots_[slot];
+        if (timer.next_)
+        {
+            timer.next_->prev_ = &timer;
+        }
+        slots_[slot] = &timer;
+    }
+
+    void TimingWheel::unlink(Timer &timer)
+    {
+        if (timer.prev_)
+        {
+            timer.prev_->next_ = timer.next_;
+        }
+        else
+        {
+            slots_[timer.slot_] = timer.next_;
+        }
+        if (timer.next_)
+        {
+            timer.next_->prev_ = timer.prev_;
+        }
+        timer.wheel_ = nullptr;
+        timer.prev_ = nullptr;
+        timer.next_ = nullptr;
+    }
+}
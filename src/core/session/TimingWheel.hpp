@@ -0,0 +1,95 @@
+#ifndef TIMINGWHEEL_HPP
+#define TIMINGWHEEL_HPP
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Softadastra
+{
+    namespace net = boost::asio;
+
+    // Roue temporelle hachée : un seul steady_timer par io_context, qui avance d'une case
+    // à chaque tick. Armer et annuler une échéance est en O(1) et sans allocation, car les
+    // entrées (Timer) sont chaînées directement dans les objets qui les possèdent.
+    //
+    // Les échéances arrivées sont d'abord retirées de leur case sous le verrou, puis
+    // on_expire() est appelé verrou relâché : en mode "shared", les autres threads io
+    // peuvent armer et annuler pendant ce temps. cancel() attend la fin d'un on_expire()
+    // en cours sur un autre thread : le propriétaire l'appelle avant de détruire le Timer.
+    class TimingWheel
+    {
+    public:
+        class Timer
+        {
+        public:
+            Timer() = default;
+            virtual ~Timer() = default;
+            Timer(const Timer &) = delete;
+            Timer &operator=(const Timer &) = delete;
+
+            bool armed() const { return wheel_ != nullptr; }
+            // Incrémenté à chaque arm() : permet d'ignorer une expiration devenue obsolète.
+            // À lire depuis le thread qui arme ; le tick passe la sienne à on_expire().
+            std::uint64_t generation() const { return generation_; }
+
+        protected:
+            // Appelé depuis le tick, verrou de la roue relâché : doit rendre la main vite
+            // (par exemple via net::post), le tick attend les échéances suivantes.
+            // generation : celle de l'échéance expirée, relevée sous le verrou.
+            virtual void on_expire(std::uint64_t generation) = 0;
+
+        private:
+            friend class TimingWheel;
+            TimingWheel *wheel_ = nullptr;
+            Timer *prev_ = nullptr;
+            Timer *next_ = nullptr;
+            std::size_t slot_ = 0;
+            std::size_t rounds_ = 0;
+            std::uint64_t generation_ = 0;
+        };
+
+        static constexpr std::chrono::milliseconds DEFAULT_TICK{250};
+        static constexpr std::size_t DEFAULT_SLOTS = 512; // puissance de 2
+
+        explicit TimingWheel(net::io_context &io_context,
+                             std::chrono::milliseconds tick = DEFAULT_TICK,
+                             std::size_t slots = DEFAULT_SLOTS);
+        ~TimingWheel();
+        TimingWheel(const TimingWheel &) = delete;
+        TimingWheel &operator=(const TimingWheel &) = delete;
+
+        void start();
+        void stop();
+        void arm(Timer &timer, std::chrono::milliseconds timeout);
+        void cancel(Timer &timer);
+
+    private:
+        void schedule_tick();
+        void on_tick();
+        void fire_due();
+        void link(Timer &timer, std::size_t slot);
+        void unlink(Timer &timer);
+
+        net::steady_timer tick_timer_;
+        std::chrono::milliseconds tick_;
+        std::chrono::steady_clock::time_point next_tick_;
+        std::vector<Timer *> slots_; // une case de plus, due_slot_ : échéances à déclencher
+        std::size_t mask_;
+        std::size_t due_slot_;
+        std::size_t cursor_;
+        bool running_;
+        // Un shard "sharded" n'a qu'un thread : le verrou n'y est jamais disputé. En mode
+        // "shared", les sessions d'un même io_context tournent sur plusieurs threads.
+        std::mutex mutex_;
+        std::condition_variable fired_;
+        Timer *firing_;                 // on_expire() en cours, hors verrou
+        std::thread::id firing_thread_; // thread du tick qui l'appelle
+    };
+}
+
+#endif // TIMINGWHEEL_HPP
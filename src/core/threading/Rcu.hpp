@@ -0,0 +1,107 @@
+#ifndef RCU_HPP
+#define RCU_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Softadastra
+{
+    // Objet immuable publié à la manière de RCU. Un lecteur ne prend aucun verrou : il se
+    // déclare dans un compteur de la génération courante, lit le pointeur, et se retire à
+    // la fin de la garde. Un écrivain échange le pointeur, bascule la génération puis
+    // attend que les lecteurs de l'ancienne soient sortis avant de libérer l'ancien objet.
+    //
+    // Les sections de lecture doivent rester courtes (une recherche, pas un handler) : un
+    // écrivain attend la plus longue d'entre elles.
+    template <typename T>
+    class RcuPointer
+    {
+    public:
+        class ReadGuard
+        {
+        public:
+            ReadGuard(const ReadGuard &) = delete;
+            ReadGuard &operator=(const ReadGuard &) = delete;
+            ~ReadGuard() { counter_.fetch_sub(1, std::memory_order_release); }
+
+            const T *get() const { return value_; }
+            const T *operator->() const { return value_; }
+            const T &operator*() const { return *value_; }
+
+        private:
+            friend class RcuPointer;
+            ReadGuard(std::atomic<std::uint64_t> &counter, const T *value) : counter_(counter), value_(value) {}
+
+            std::atomic<std::uint64_t> &counter_;
+            const T *value_;
+        };
+
+        explicit RcuPointer(std::unique_ptr<const T> initial) : current_(initial.release()) {}
+        ~RcuPointer() { delete current_.load(); }
+        RcuPointer(const RcuPointer &) = delete;
+        RcuPointer &operator=(const RcuPointer &) = delete;
+
+        ReadGuard read() const
+        {
+            // Compteurs répartis par thread : les lecteurs ne se disputent pas une ligne de cache.
+            static std::atomic<unsigned> next_stripe{0};
+            thread_local const unsigned stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+            for (;;)
+            {
+                const unsigned epoch = epoch_.load();
+                std::atomic<std::uint64_t> &counter = readers_[epoch & 1][stripe].count;
+                counter.fetch_add(1);
+                // Génération basculée entre-temps : l'écrivain a pu ne pas voir ce lecteur.
+                if (epoch_.load() == epoch)
+                {
+                    return ReadGuard(counter, current_.load());
+                }
+                counter.fetch_sub(1);
+            }
+        }
+
+        // Publie value ; l'ancienne version est libérée une fois la période de grâce écoulée.
+        void publish(std::unique_ptr<const T> value)
+        {
+            std::lock_guard<std::mutex> lock(writer_);
+            std::unique_ptr<const T> previous(current_.exchange(value.release()));
+            // Les lecteurs de la génération e ont pu voir previous ; ceux qui arrivent
+            // après la bascule comptent dans l'autre génération et voient value.
+            const unsigned epoch = epoch_.fetch_add(1);
+            while (active_readers(epoch & 1) != 0)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+    private:
+        static constexpr unsigned STRIPES = 16;
+
+        struct alignas(64) Counter
+        {
+            std::atomic<std::uint64_t> count{0};
+        };
+
+        std::uint64_t active_readers(unsigned generation) const
+        {
+            std::uint64_t total = 0;
+            for (const Counter &counter : readers_[generation])
+            {
+                total += counter.count.load();
+            }
+            return total;
+        }
+
+        std::atomic<const T *> current_;
+        std::atomic<unsigned> epoch_{0};
+        mutable std::array<std::array<Counter, STRIPES>, 2> readers_{};
+        std::mutex writer_;
+    };
+}
+
+#endif // RCU_HPP
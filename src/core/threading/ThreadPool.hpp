@@ -57,6 +57,7 @@ namespace Softadastra
         size_t maxThreads;
         std::unordered_map<std::thread::id, int> threadAffinity;
         std::atomic<int> activeTasks;
+        size_t idleWorkers; // threads en attente d'une tâche (protégé par m)
 
         // Nouveau membre pour stocker la priorité des threads
         int threadPriority; // Priorité des threads
@@ -81,6 +82,7 @@ namespace Softadastra
               stopPeriodic(false),
               maxThreads(maxThreadCount),
               activeTasks(0),
+              idleWorkers(0),
               threadPriority(priority) // Initialisation correcte
         {
             // Initialisation des threads
@@ -105,7 +107,9 @@ namespace Softadastra
                     Task task;
                     {
                         std::unique_lock<std::mutex> lock(m);
+                        ++idleWorkers;
                         condition.wait(lock, [this] { return stop || !tasks.empty(); });
+                        --idleWorkers;
     
                         if (stop && tasks.empty()) return;
     
@@ -145,7 +149,9 @@ namespace Softadastra
                                              },
                                              priority});
 
-                if (workers.size() < maxThreads)
+                // Un nouveau thread seulement si aucun worker libre ne peut prendre la tâche :
+                // sinon chaque enqueue ferait grossir le pool jusqu'à maxThreads.
+                if (tasks.size() > idleWorkers && workers.size() < maxThreads)
                 {
                     createThread(workers.size());
                 }
@@ -0,0 +1,281 @@
+#include "TlsContext.hpp"
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/core_names.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Softadastra
+{
+    namespace
+    {
+        // Clé courante + deux précédentes : un ticket reste déchiffrable deux rotations.
+        constexpr std::size_t MAX_TICKET_KEYS = 3;
+        const unsigned char SESSION_ID_CONTEXT[] = "softadastra";
+
+        std::string openssl_error()
+        {
+            unsigned long code = ERR_get_error();
+            if (code == 0)
+            {
+                return "unknown error";
+            }
+            char buffer[256];
+            ERR_error_string_n(code, buffer, sizeof(buffer));
+            ERR_clear_error();
+            return buffer;
+        }
+    }
+
+    TlsContext::TlsContext(const Options &options)
+        : ctx_(SSL_CTX_new(TLS_server_method())),
+          options_(options),
+          keys_mutex_(),
+          ticket_keys_(),
+          full_handshakes_(0),
+          resumed_handshakes_(0),
+          failed_handshakes_(0),
+          handshake_time_us_(0),
+          ticket_key_rotations_(0),
+          tickets_renewed_(0),
+          ktls_connections_(0),
+          ktls_fallbacks_(0),
+          ktls_fallback_logged_(false)
+    {
+        if (!ctx_)
+        {
+            throw std::runtime_error("SSL_CTX_new failed: " + openssl_error());
+        }
+
+        try
+        {
+            SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+            SSL_CTX_set_options(ctx_, SSL_OP_NO_COMPRESSION | SSL_OP_CIPHER_SERVER_PREFERENCE | SSL_OP_NO_RENEGOTIATION |
+                                      SSL_OP_IGNORE_UNEXPECTED_EOF);
+            // Écritures partielles sur socket non bloquante ; tampons libérés entre deux requêtes.
+            SSL_CTX_set_mode(ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER | SSL_MODE_RELEASE_BUFFERS);
+            if (options_.ktls)
+            {
+                // OpenSSL confie les clés au noyau à la fin du handshake si le module tls et
+                // la suite négociée le permettent ; sinon il reste silencieusement en espace
+                // utilisateur (voir record_ktls).
+                SSL_CTX_set_options(ctx_, SSL_OP_ENABLE_KTLS);
+            }
+
+            if (SSL_CTX_use_certificate_chain_file(ctx_, options_.certificate_file.c_str()) != 1)
+            {
+                throw std::runtime_error("Cannot load TLS certificate " + options_.certificate_file + ": " + openssl_error());
+            }
+            if (SSL_CTX_use_PrivateKey_file(ctx_, options_.private_key_file.c_str(), SSL_FILETYPE_PEM) != 1)
+            {
+                throw std::runtime_error("Cannot load TLS private key " + options_.private_key_file + ": " + openssl_error());
+            }
+            if (SSL_CTX_check_private_key(ctx_) != 1)
+            {
+                throw std::runtime_error("TLS private key does not match the certificate: " + openssl_error());
+            }
+
+            // Cache côté serveur (reprise par identifiant de session, TLS 1.2) partagé par
+            // tous les threads via le SSL_CTX ; TLS 1.3 et les clients récents passent par
+            // les tickets, chiffrés avec nos propres clés.
+            SSL_CTX_set_session_id_context(ctx_, SESSION_ID_CONTEXT, sizeof(SESSION_ID_CONTEXT) - 1);
+            SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_SERVER);
+            SSL_CTX_sess_set_cache_size(ctx_, options_.session_cache_size);
+            SSL_CTX_set_timeout(ctx_, static_cast<long>(options_.session_timeout.count()));
+
+            SSL_CTX_set_app_data(ctx_, this);
+            ticket_keys_.push_front(make_ticket_key());
+            if (SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx_, &TlsContext::ticket_key_callback) != 1)
+            {
+                throw std::runtime_error("Cannot install the TLS ticket key callback: " + openssl_error());
+            }
+        }
+        catch (...)
+        {
+            SSL_CTX_free(ctx_);
+            throw;
+        }
+    }
+
+    TlsContext::~TlsContext()
+    {
+        SSL_CTX_free(ctx_);
+        std::lock_guard<std::mutex> lock(keys_mutex_);
+        for (TicketKey &key : ticket_keys_)
+        {
+            OPENSSL_cleanse(key.aes_key.data(), key.aes_key.size());
+            OPENSSL_cleanse(key.hmac_key.data(), key.hmac_key.size());
+        }
+    }
+
+    TlsContext::TicketKey TlsContext::make_ticket_key()
+    {
+        TicketKey key;
+        if (RAND_bytes(key.name.data(), static_cast<int>(key.name.size())) != 1 ||
+            RAND_bytes(key.aes_key.data(), static_cast<int>(key.aes_key.size())) != 1 ||
+            RAND_bytes(key.hmac_key.data(), static_cast<int>(key.hmac_key.size())) != 1)
+        {
+            throw std::runtime_error("RAND_bytes failed while generating a TLS ticket key");
+        }
+        key.created = std::chrono::steady_clock::now();
+        return key;
+    }
+
+    void TlsContext::rotate_ticket_keys(std::chrono::seconds older_than)
+    {
+        TicketKey key = make_ticket_key();
+        std::lock_guard<std::mutex> lock(keys_mutex_);
+        if (key.created - ticket_keys_.front().created < older_than)
+        {
+            // Un autre thread vient de faire la rotation : la clé courante reste.
+            OPENSSL_cleanse(key.aes_key.data(), key.aes_key.size());
+            OPENSSL_cleanse(key.hmac_key.data(), key.hmac_key.size());
+            return;
+        }
+        ticket_keys_.push_front(key);
+        while (ticket_keys_.size() > MAX_TICKET_KEYS)
+        {
+            OPENSSL_cleanse(ticket_keys_.back().aes_key.data(), ticket_keys_.back().aes_key.size());
+            OPENSSL_cleanse(ticket_keys_.back().hmac_key.data(), ticket_keys_.back().hmac_key.size());
+            ticket_keys_.pop_back();
+        }
+        ticket_key_rotations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int TlsContext::ticket_key_callback(SSL *ssl, unsigned char key_name[16], unsigned char *iv,
+                                        EVP_CIPHER_CTX *cipher, EVP_MAC_CTX *mac, int encrypt)
+    {
+        // Callback C d'OpenSSL : aucune exception ne doit le traverser.
+        TlsContext *self = static_cast<TlsContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        try
+        {
+            return self->handle_ticket_key(key_name, iv, cipher, mac, encrypt);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("TLS ticket key callback failed: {}", e.what());
+            return -1;
+        }
+    }
+
+    int TlsContext::handle_ticket_key(unsigned char key_name[16], unsigned char *iv,
+                                      EVP_CIPHER_CTX *cipher, EVP_MAC_CTX *mac, int encrypt)
+    {
+        // Valeurs de retour OpenSSL : 1 ticket accepté/émis, 2 accepté mais à renouveler,
+        // 0 ticket inconnu (handshake complet), -1 erreur.
+        if (encrypt)
+        {
+            // Rotation paresseuse : au premier ticket émis après l'échéance.
+            bool rotate = false;
+            {
+                std::lock_guard<std::mutex> lock(keys_mutex_);
+                rotate = std::chrono::steady_clock::now() - ticket_keys_.front().created >= options_.ticket_key_rotation;
+            }
+            if (rotate)
+            {
+                rotate_ticket_keys(options_.ticket_key_rotation);
+            }
+        }
+
+        TicketKey key;
+        bool current = false;
+        {
+            std::lock_guard<std::mutex> lock(keys_mutex_);
+            if (encrypt)
+            {
+                key = ticket_keys_.front();
+                current = true;
+            }
+            else
+            {
+                auto it = std::find_if(ticket_keys_.begin(), ticket_keys_.end(), [key_name](const TicketKey &candidate)
+                                       { return std::memcmp(candidate.name.data(), key_name, candidate.name.size()) == 0; });
+                if (it == ticket_keys_.end())
+                {
+                    return 0;
+                }
+                key = *it;
+                current = it == ticket_keys_.begin();
+            }
+        }
+
+        OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac_key.data(), key.hmac_key.size()),
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char *>("SHA256"), 0),
+            OSSL_PARAM_construct_end()};
+
+        int result = 1;
+        if (encrypt)
+        {
+            std::memcpy(key_name, key.name.data(), key.name.size());
+            if (RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1 ||
+                EVP_EncryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key.aes_key.data(), iv) != 1 ||
+                EVP_MAC_CTX_set_params(mac, params) != 1)
+            {
+                result = -1;
+            }
+        }
+        else
+        {
+            if (EVP_MAC_CTX_set_params(mac, params) != 1 ||
+                EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key.aes_key.data(), iv) != 1)
+            {
+                result = -1;
+            }
+            else if (!current)
+            {
+                tickets_renewed_.fetch_add(1, std::memory_order_relaxed);
+                result = 2;
+            }
+        }
+
+        OPENSSL_cleanse(key.aes_key.data(), key.aes_key.size());
+        OPENSSL_cleanse(key.hmac_key.data(), key.hmac_key.size());
+        return result;
+    }
+
+    void TlsContext::record_handshake(bool resumed, std::chrono::microseconds duration)
+    {
+        (resumed ? resumed_handshakes_ : full_handshakes_).fetch_add(1, std::memory_order_relaxed);
+        handshake_time_us_.fetch_add(static_cast<std::uint64_t>(duration.count()), std::memory_order_relaxed);
+    }
+
+    void TlsContext::record_handshake_failure()
+    {
+        failed_handshakes_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TlsContext::record_ktls(bool offloaded)
+    {
+        if (offloaded)
+        {
+            ktls_connections_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ktls_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        if (!ktls_fallback_logged_.exchange(true, std::memory_order_relaxed))
+        {
+            spdlog::warn("kTLS requested but not available for this connection (kernel tls module or cipher), "
+                         "using userspace encryption");
+        }
+    }
+
+    TlsContext::Stats TlsContext::stats() const
+    {
+        return Stats{full_handshakes_.load(std::memory_order_relaxed),
+                     resumed_handshakes_.load(std::memory_order_relaxed),
+                     failed_handshakes_.load(std::memory_order_relaxed),
+                     handshake_time_us_.load(std::memory_order_relaxed),
+                     ticket_key_rotations_.load(std::memory_order_relaxed),
+                     tickets_renewed_.load(std::memory_order_relaxed),
+                     SSL_CTX_sess_hits(ctx_),
+                     SSL_CTX_sess_misses(ctx_),
+                     SSL_CTX_sess_number(ctx_),
+                     ktls_connections_.load(std::memory_order_relaxed),
+                     ktls_fallbacks_.load(std::memory_order_relaxed)};
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef TLSCONTEXT_HPP
+#define TLSCONTEXT_HPP
+
+#include <openssl/ssl.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace Softadastra
+{
+    // Contexte TLS unique du serveur, partagé par tous les shards : un seul cache de
+    // sessions (reprise par identifiant) et un seul jeu de clés de tickets, renouvelé
+    // périodiquement. Les clés précédentes restent acceptées le temps d'une rotation.
+    class TlsContext
+    {
+    public:
+        struct Options
+        {
+            std::string certificate_file;
+            std::string private_key_file;
+            long session_cache_size = 20480;
+            std::chrono::seconds session_timeout{300};
+            std::chrono::seconds ticket_key_rotation{3600};
+            bool ktls = false; // chiffrement des envois par le noyau (kTLS) si disponible
+        };
+
+        struct Stats
+        {
+            std::uint64_t full_handshakes;
+            std::uint64_t resumed_handshakes;
+            std::uint64_t failed_handshakes;
+            std::uint64_t handshake_time_us; // cumul, handshakes réussis
+            std::uint64_t ticket_key_rotations;
+            std::uint64_t tickets_renewed; // ticket valide mais clé ancienne : nouveau ticket émis
+            long session_cache_hits;
+            long session_cache_misses;
+            long session_cache_size;
+            std::uint64_t ktls_connections;   // envois chiffrés par le noyau
+            std::uint64_t ktls_fallbacks;     // kTLS demandé mais refusé (noyau, chiffrement)
+        };
+
+        explicit TlsContext(const Options &options);
+        ~TlsContext();
+        TlsContext(const TlsContext &) = delete;
+        TlsContext &operator=(const TlsContext &) = delete;
+
+        SSL_CTX *native_handle() const { return ctx_; }
+        bool ktls_enabled() const { return options_.ktls; }
+
+        // Nouvelle clé courante. Avec older_than, seulement si la clé courante a au moins
+        // cet âge, vérifié sous le verrou : deux handshakes simultanés ne font qu'une rotation.
+        void rotate_ticket_keys(std::chrono::seconds older_than = std::chrono::seconds(0));
+        void record_handshake(bool resumed, std::chrono::microseconds duration);
+        void record_handshake_failure();
+        void record_ktls(bool offloaded);
+        Stats stats() const;
+
+    private:
+        struct TicketKey
+        {
+            std::array<unsigned char, 16> name;
+            std::array<unsigned char, 32> aes_key;
+            std::array<unsigned char, 32> hmac_key;
+            std::chrono::steady_clock::time_point created;
+        };
+
+        static int ticket_key_callback(SSL *ssl, unsigned char key_name[16], unsigned char *iv,
+                                       EVP_CIPHER_CTX *cipher, EVP_MAC_CTX *mac, int encrypt);
+        int handle_ticket_key(unsigned char key_name[16], unsigned char *iv,
+                              EVP_CIPHER_CTX *cipher, EVP_MAC_CTX *mac, int encrypt);
+        static TicketKey make_ticket_key();
+
+        SSL_CTX *ctx_;
+        const Options options_;
+        std::mutex keys_mutex_;
+        std::deque<TicketKey> ticket_keys_; // en tête : clé courante
+        std::atomic<std::uint64_t> full_handshakes_;
+        std::atomic<std::uint64_t> resumed_handshakes_;
+        std::atomic<std::uint64_t> failed_handshakes_;
+        std::atomic<std::uint64_t> handshake_time_us_;
+        std::atomic<std::uint64_t> ticket_key_rotations_;
+        std::atomic<std::uint64_t> tickets_renewed_;
+        std::atomic<std::uint64_t> ktls_connections_;
+        std::atomic<std::uint64_t> ktls_fallbacks_;
+        std::atomic<bool> ktls_fallback_logged_;
+    };
+}
+
+#endif // TLSCONTEXT_HPP
@@ -0,0 +1,111 @@
+#include "TlsStream.hpp"
+#include <openssl/err.h>
+#include <boost/asio/error.hpp>
+#include <boost/asio/ssl/error.hpp>
+#include <cerrno>
+#include <stdexcept>
+
+namespace Softadastra
+{
+    TlsStream::~TlsStream()
+    {
+        reset();
+    }
+
+    void TlsStream::attach(SSL_CTX *ctx, int fd)
+    {
+        reset();
+        ssl_ = SSL_new(ctx);
+        if (!ssl_ || SSL_set_fd(ssl_, fd) != 1)
+        {
+            reset();
+            throw std::runtime_error("Cannot create the TLS connection state");
+        }
+        SSL_set_accept_state(ssl_);
+    }
+
+    void TlsStream::reset()
+    {
+        if (ssl_)
+        {
+            SSL_free(ssl_);
+            ssl_ = nullptr;
+        }
+        error_ = {};
+    }
+
+    TlsStream::Status TlsStream::handshake()
+    {
+        ERR_clear_error();
+        return status(SSL_do_handshake(ssl_));
+    }
+
+    TlsStream::Status TlsStream::read(void *data, std::size_t size, std::size_t &transferred)
+    {
+        ERR_clear_error();
+        transferred = 0;
+        return status(SSL_read_ex(ssl_, data, size, &transferred));
+    }
+
+    TlsStream::Status TlsStream::write(const void *data, std::size_t size, std::size_t &transferred)
+    {
+        ERR_clear_error();
+        transferred = 0;
+        return status(SSL_write_ex(ssl_, data, size, &transferred));
+    }
+
+    void TlsStream::shutdown()
+    {
+        // Uniquement si le handshake a abouti ; après une erreur fatale, status() a déjà
+        // marqué la connexion comme fermée.
+        if (ssl_ && SSL_is_init_finished(ssl_) && !(SSL_get_shutdown(ssl_) & SSL_SENT_SHUTDOWN))
+        {
+            ERR_clear_error();
+            SSL_shutdown(ssl_);
+            ERR_clear_error();
+        }
+    }
+
+    bool TlsStream::resumed() const
+    {
+        return ssl_ && SSL_session_reused(ssl_) == 1;
+    }
+
+    bool TlsStream::ktls_send() const
+    {
+        return ssl_ && BIO_get_ktls_send(SSL_get_wbio(ssl_)) == 1;
+    }
+
+    TlsStream::Status TlsStream::status(int result)
+    {
+        // SSL_do_handshake renvoie 1 en cas de succès, les variantes _ex également.
+        if (result == 1)
+        {
+            return Status::Done;
+        }
+
+        switch (SSL_get_error(ssl_, result))
+        {
+        case SSL_ERROR_WANT_READ:
+            return Status::WantRead;
+        case SSL_ERROR_WANT_WRITE:
+            return Status::WantWrite;
+        case SSL_ERROR_ZERO_RETURN:
+            error_ = boost::asio::error::eof;
+            return Status::Closed;
+        case SSL_ERROR_SYSCALL:
+            // errno == 0 : fin de flux sans close_notify (client fermé brutalement).
+            error_ = errno != 0 ? boost::system::error_code(errno, boost::system::system_category())
+                                : boost::system::error_code(boost::asio::ssl::error::stream_truncated);
+            ERR_clear_error();
+            // Plus aucun SSL_shutdown possible après une erreur d'E/S.
+            SSL_set_shutdown(ssl_, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+            return Status::Error;
+        default:
+            error_ = boost::system::error_code(static_cast<int>(ERR_get_error()), boost::asio::error::get_ssl_category());
+            ERR_clear_error();
+            SSL_set_shutdown(ssl_, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+            return Status::Error;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef TLSSTREAM_HPP
+#define TLSSTREAM_HPP
+
+#include <openssl/ssl.h>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+
+namespace Softadastra
+{
+    // Connexion TLS côté serveur, liée directement au descripteur de la socket (pas de
+    // paire de BIO mémoire : les enregistrements chiffrés ne sont pas recopiés). Les appels
+    // ne bloquent jamais ; WantRead/WantWrite indiquent quelle disponibilité attendre.
+    class TlsStream
+    {
+    public:
+        enum class Status
+        {
+            Done,
+            WantRead,
+            WantWrite,
+            Closed, // close_notify reçu
+            Error
+        };
+
+        TlsStream() = default;
+        ~TlsStream();
+        TlsStream(const TlsStream &) = delete;
+        TlsStream &operator=(const TlsStream &) = delete;
+
+        void attach(SSL_CTX *ctx, int fd);
+        void reset();
+        bool active() const { return ssl_ != nullptr; }
+
+        Status handshake();
+        Status read(void *data, std::size_t size, std::size_t &transferred);
+        Status write(const void *data, std::size_t size, std::size_t &transferred);
+        // close_notify, sans attendre celui du client.
+        void shutdown();
+
+        bool resumed() const;
+        // Envois chiffrés par le noyau : un write()/sendfile() en clair sur la socket produit
+        // directement des enregistrements TLS.
+        bool ktls_send() const;
+        // Dernière erreur TLS, à journaliser ou à remonter au handler.
+        boost::system::error_code error() const { return error_; }
+
+    private:
+        Status status(int result);
+
+        SSL *ssl_ = nullptr;
+        boost::system::error_code error_;
+    };
+}
+
+#endif // TLSSTREAM_HPP
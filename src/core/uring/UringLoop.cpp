@@ -0,0 +1,730 @@
+#include "UringLoop.hpp"
+#include "logging/AsyncLog.hpp"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(IORING_ACCEPT_MULTISHOT) // en-têtes 5.19+ : accept multishot et anneaux de tampons
+#define SOFTADASTRA_HAS_IO_URING 1
+#endif
+
+namespace Softadastra
+{
+#ifdef SOFTADASTRA_HAS_IO_URING
+
+    namespace
+    {
+        // user_data : adresse du Stream (alignée) et type d'opération dans les bits bas.
+        enum Operation : std::uint64_t
+        {
+            OP_ACCEPT = 1,
+            OP_RECV = 2,
+            OP_WRITE = 3,
+            OP_CLOSE = 4,
+            OP_CANCEL = 5
+        };
+        constexpr std::uint64_t OP_MASK = 7;
+        constexpr std::uint16_t BUFFER_GROUP = 0;
+
+        int io_uring_setup(unsigned entries, io_uring_params *params)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+        }
+
+        int io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+        }
+
+        std::uint64_t tag(void *target, Operation op)
+        {
+            return reinterpret_cast<std::uint64_t>(target) | op;
+        }
+
+        boost::system::error_code to_error_code(std::int32_t res)
+        {
+            if (res == 0)
+            {
+                return net::error::eof;
+            }
+            return boost::system::error_code(-res, boost::system::system_category());
+        }
+    }
+
+    // Anneaux partagés avec le noyau (SQ, CQ, SQE) et anneau de tampons de lecture.
+    struct UringLoop::Ring
+    {
+        int fd = -1;
+        void *sq_ptr = MAP_FAILED;
+        void *cq_ptr = MAP_FAILED;
+        std::size_t sq_size = 0;
+        std::size_t cq_size = 0;
+        io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+        std::size_t sqes_size = 0;
+
+        unsigned *sq_head = nullptr;
+        unsigned *sq_tail = nullptr;
+        unsigned *sq_array = nullptr;
+        unsigned sq_mask = 0;
+        unsigned sq_entries = 0;
+        unsigned *cq_head = nullptr;
+        unsigned *cq_tail = nullptr;
+        io_uring_cqe *cqes = nullptr;
+        unsigned cq_mask = 0;
+
+        unsigned sq_local_tail = 0; // SQE préparées, pas encore publiées au noyau
+        unsigned to_submit = 0;
+
+        io_uring_buf_ring *buf_ring = static_cast<io_uring_buf_ring *>(MAP_FAILED);
+        std::size_t buf_ring_size = 0;
+        std::vector<char> buffers;
+        bool buf_ring_registered = false;
+
+        explicit Ring(unsigned entries)
+        {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            fd = io_uring_setup(entries, &params);
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::system_category(), "io_uring_setup");
+            }
+
+            sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap)
+            {
+                sq_size = cq_size = std::max(sq_size, cq_size);
+            }
+
+            sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sq_ptr == MAP_FAILED)
+            {
+                release();
+                throw std::system_error(errno, std::system_category(), "io_uring mmap (SQ)");
+            }
+            cq_ptr = single_mmap ? sq_ptr
+                                 : ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cq_ptr == MAP_FAILED)
+            {
+                release();
+                throw std::system_error(errno, std::system_category(), "io_uring mmap (CQ)");
+            }
+
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+            if (sqes == MAP_FAILED)
+            {
+                release();
+                throw std::system_error(errno, std::system_category(), "io_uring mmap (SQE)");
+            }
+
+            char *sq = static_cast<char *>(sq_ptr);
+            char *cq = static_cast<char *>(cq_ptr);
+            sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+            sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+            sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+            sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+            sq_entries = params.sq_entries;
+            cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+            cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+            cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+            sq_local_tail = *sq_tail;
+        }
+
+        ~Ring()
+        {
+            release();
+        }
+
+        void release()
+        {
+            if (buf_ring_registered)
+            {
+                io_uring_buf_reg reg;
+                std::memset(&reg, 0, sizeof(reg));
+                reg.bgid = BUFFER_GROUP;
+                io_uring_register(fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+                buf_ring_registered = false;
+            }
+            if (buf_ring != MAP_FAILED)
+            {
+                ::munmap(buf_ring, buf_ring_size);
+                buf_ring = static_cast<io_uring_buf_ring *>(MAP_FAILED);
+            }
+            if (sqes != MAP_FAILED)
+            {
+                ::munmap(sqes, sqes_size);
+                sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+            }
+            if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr)
+            {
+                ::munmap(cq_ptr, cq_size);
+            }
+            cq_ptr = MAP_FAILED;
+            if (sq_ptr != MAP_FAILED)
+            {
+                ::munmap(sq_ptr, sq_size);
+                sq_ptr = MAP_FAILED;
+            }
+            if (fd >= 0)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        // Enregistre l'anneau de tampons de lecture (groupe BUFFER_GROUP) : le noyau choisit
+        // lui-même un tampon libre au moment où les données arrivent.
+        void register_buffers(unsigned count, std::size_t size)
+        {
+            buf_ring_size = count * sizeof(io_uring_buf);
+            buf_ring = static_cast<io_uring_buf_ring *>(::mmap(nullptr, buf_ring_size, PROT_READ | PROT_WRITE,
+                                                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+            if (buf_ring == MAP_FAILED)
+            {
+                throw std::system_error(errno, std::system_category(), "io_uring buffer ring mmap");
+            }
+
+            io_uring_buf_reg reg;
+            std::memset(&reg, 0, sizeof(reg));
+            reg.ring_addr = reinterpret_cast<std::uint64_t>(buf_ring);
+            reg.ring_entries = count;
+            reg.bgid = BUFFER_GROUP;
+            if (io_uring_register(fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+            {
+                throw std::system_error(errno, std::system_category(), "IORING_REGISTER_PBUF_RING");
+            }
+            buf_ring_registered = true;
+
+            buffers.resize(count * size);
+            for (unsigned bid = 0; bid < count; ++bid)
+            {
+                add_buffer(bid, bid, size);
+            }
+            publish_buffers(count);
+        }
+
+        void add_buffer(unsigned offset, unsigned bid, std::size_t size)
+        {
+            const unsigned mask = static_cast<unsigned>(buf_ring_size / sizeof(io_uring_buf)) - 1;
+            // Pas de buf_ring->bufs : en C++, __DECLARE_FLEX_ARRAY le décale de 8 octets.
+            io_uring_buf &buf = reinterpret_cast<io_uring_buf *>(buf_ring)[(buf_ring->tail + offset) & mask];
+            buf.addr = reinterpret_cast<std::uint64_t>(buffers.data() + bid * size);
+            buf.len = static_cast<std::uint32_t>(size);
+            buf.bid = static_cast<std::uint16_t>(bid);
+        }
+
+        void publish_buffers(unsigned count)
+        {
+            __atomic_store_n(&buf_ring->tail, static_cast<std::uint16_t>(buf_ring->tail + count), __ATOMIC_RELEASE);
+        }
+
+        // nullptr si la file de soumission est pleine (l'appelant soumet puis réessaie).
+        io_uring_sqe *get_sqe()
+        {
+            const unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+            if (sq_local_tail - head >= sq_entries)
+            {
+                return nullptr;
+            }
+            const unsigned index = sq_local_tail & sq_mask;
+            io_uring_sqe *sqe = &sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sq_array[index] = index;
+            ++sq_local_tail;
+            ++to_submit;
+            return sqe;
+        }
+
+        unsigned pending() const
+        {
+            return to_submit;
+        }
+
+        int submit()
+        {
+            __atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+            int ret = io_uring_enter(fd, to_submit, 0, 0);
+            if (ret >= 0)
+            {
+                to_submit -= static_cast<unsigned>(ret);
+            }
+            return ret;
+        }
+    };
+
+    bool UringLoop::supported()
+    {
+        try
+        {
+            Ring ring(8);
+
+            std::vector<char> storage(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+            io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(storage.data());
+            if (io_uring_register(ring.fd, IORING_REGISTER_PROBE, probe, 256) < 0)
+            {
+                return false;
+            }
+            for (unsigned op : {IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SENDMSG, IORING_OP_CLOSE, IORING_OP_ASYNC_CANCEL})
+            {
+                if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+                {
+                    return false;
+                }
+            }
+
+            // Les anneaux de tampons fournis et l'accept multishot datent du même noyau (5.19).
+            ring.register_buffers(1, 64);
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::debug("io_uring probe failed: {}", e.what());
+            return false;
+        }
+    }
+
+    UringLoop::UringLoop(net::io_context &io_context)
+        : io_context_(io_context),
+          ring_(std::make_unique<Ring>(URING_QUEUE_DEPTH)),
+          ring_watch_(io_context),
+          listen_fd_(-1),
+          accept_handler_(),
+          accept_armed_(false),
+          accept_paused_(false),
+          flush_scheduled_(false),
+          running_(false),
+          submit_calls_(0),
+          submitted_(0),
+          completions_(0),
+          buffer_exhausted_(0)
+    {
+        ring_->register_buffers(URING_BUFFER_COUNT, URING_BUFFER_SIZE);
+
+        int watch_fd = ::dup(ring_->fd);
+        if (watch_fd < 0)
+        {
+            throw std::system_error(errno, std::system_category(), "dup(io_uring fd)");
+        }
+        ring_watch_.assign(watch_fd);
+    }
+
+    UringLoop::~UringLoop()
+    {
+        boost::system::error_code ec;
+        ring_watch_.close(ec);
+    }
+
+    void UringLoop::start()
+    {
+        running_ = true;
+        wait_completions();
+    }
+
+    void UringLoop::stop()
+    {
+        running_ = false;
+        boost::system::error_code ec;
+        ring_watch_.cancel(ec);
+    }
+
+    void UringLoop::listen(int listen_fd, AcceptHandler handler)
+    {
+        listen_fd_ = listen_fd;
+        accept_handler_ = std::move(handler);
+        submit_accept();
+    }
+
+    void UringLoop::pause_accept()
+    {
+        if (accept_paused_)
+        {
+            return;
+        }
+        accept_paused_ = true;
+        if (accept_armed_)
+        {
+            io_uring_sqe *sqe = nullptr;
+            while (!(sqe = ring_->get_sqe()))
+            {
+                flush();
+            }
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = tag(this, OP_ACCEPT);
+            sqe->user_data = OP_CANCEL;
+            schedule_flush();
+        }
+    }
+
+    void UringLoop::resume_accept()
+    {
+        if (!accept_paused_)
+        {
+            return;
+        }
+        accept_paused_ = false;
+        if (!accept_armed_)
+        {
+            submit_accept();
+        }
+    }
+
+    void UringLoop::recv(Stream &stream, int fd, net::mutable_buffer fallback, std::shared_ptr<void> owner)
+    {
+        stream.fd_ = fd;
+        stream.recv_fallback_ = fallback;
+        stream.recv_owner_ = std::move(owner);
+        submit_recv(stream, true);
+    }
+
+    void UringLoop::write(Stream &stream, int fd, const std::vector<net::const_buffer> &buffers, bool close_after,
+                          std::shared_ptr<void> owner)
+    {
+        stream.fd_ = fd;
+        stream.iov_.clear();
+        for (const net::const_buffer &buffer : buffers)
+        {
+            stream.iov_.push_back(iovec{const_cast<void *>(buffer.data()), buffer.size()});
+        }
+        stream.iov_offset_ = 0;
+        stream.written_ = 0;
+        stream.close_after_write_ = close_after;
+        stream.write_owner_ = std::move(owner);
+        submit_write(stream);
+    }
+
+    void UringLoop::close(int fd)
+    {
+        io_uring_sqe *sqe = nullptr;
+        while (!(sqe = ring_->get_sqe()))
+        {
+            flush();
+        }
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = fd;
+        sqe->user_data = OP_CLOSE;
+        schedule_flush();
+    }
+
+    UringLoop::Stats UringLoop::stats() const
+    {
+        return Stats{submit_calls_.load(std::memory_order_relaxed), submitted_.load(std::memory_order_relaxed),
+                     completions_.load(std::memory_order_relaxed), buffer_exhausted_.load(std::memory_order_relaxed)};
+    }
+
+    void UringLoop::wait_completions()
+    {
+        ring_watch_.async_wait(net::posix::stream_descriptor::wait_read,
+                               [this](boost::system::error_code ec)
+                               {
+                                   if (ec)
+                                   {
+                                       if (ec != net::error::operation_aborted)
+                                       {
+                                           spdlog::error("io_uring wait failed: {}", ec.message());
+                                       }
+                                       return;
+                                   }
+                                   process_completions();
+                                   if (running_)
+                                   {
+                                       wait_completions();
+                                   }
+                               });
+    }
+
+    void UringLoop::process_completions()
+    {
+        // La tête est relue à chaque CQE : un handler peut vider la CQ (flush sur SQ pleine).
+        for (;;)
+        {
+            const unsigned head = *ring_->cq_head;
+            if (head == __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE))
+            {
+                break;
+            }
+
+            // Copie : la CQE est rendue au noyau avant d'appeler le handler.
+            const io_uring_cqe cqe = ring_->cqes[head & ring_->cq_mask];
+            __atomic_store_n(ring_->cq_head, head + 1, __ATOMIC_RELEASE);
+            completions_.fetch_add(1, std::memory_order_relaxed);
+
+            const Operation op = static_cast<Operation>(cqe.user_data & OP_MASK);
+            Stream *stream = reinterpret_cast<Stream *>(cqe.user_data & ~OP_MASK);
+            switch (op)
+            {
+            case OP_ACCEPT:
+                complete_accept(cqe.res, cqe.flags);
+                break;
+            case OP_RECV:
+                complete_recv(*stream, cqe.res, cqe.flags);
+                break;
+            case OP_WRITE:
+                complete_write(*stream, cqe.res);
+                break;
+            case OP_CLOSE:
+            case OP_CANCEL:
+                // Fermeture liée annulée (écriture partielle) : complete_write la relance.
+                break;
+            }
+        }
+
+        // Tout ce que les handlers ont préparé part en un seul appel.
+        flush();
+    }
+
+    void UringLoop::complete_accept(std::int32_t res, std::uint32_t flags)
+    {
+        if (!(flags & IORING_CQE_F_MORE))
+        {
+            accept_armed_ = false;
+        }
+
+        if (res >= 0)
+        {
+            if (accept_paused_)
+            {
+                // Acceptée avant que l'annulation ne prenne effet : servie quand même.
+                SOFTADASTRA_LOG(spdlog::level::debug, "Connection accepted while accept() is paused");
+            }
+            accept_handler_(res);
+        }
+        else if (res != -ECANCELED)
+        {
+            spdlog::error("Error accepting connection from client: {} (Error code: {})", std::strerror(-res), -res);
+        }
+
+        if (!accept_armed_ && !accept_paused_ && running_)
+        {
+            submit_accept();
+        }
+    }
+
+    void UringLoop::complete_recv(Stream &stream, std::int32_t res, std::uint32_t flags)
+    {
+        if (res == -ENOBUFS)
+        {
+            // Tous les tampons de l'anneau sont occupés : lecture classique dans celui de la session.
+            buffer_exhausted_.fetch_add(1, std::memory_order_relaxed);
+            submit_recv(stream, false);
+            return;
+        }
+
+        std::shared_ptr<void> owner = std::move(stream.recv_owner_);
+        if (res > 0 && (flags & IORING_CQE_F_BUFFER))
+        {
+            const unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+            stream.on_recv({}, ring_->buffers.data() + bid * URING_BUFFER_SIZE, static_cast<std::size_t>(res));
+            ring_->add_buffer(0, bid, URING_BUFFER_SIZE);
+            ring_->publish_buffers(1);
+        }
+        else if (res > 0)
+        {
+            stream.on_recv({}, nullptr, static_cast<std::size_t>(res));
+        }
+        else
+        {
+            stream.on_recv(to_error_code(res), nullptr, 0);
+        }
+    }
+
+    void UringLoop::complete_write(Stream &stream, std::int32_t res)
+    {
+        if (res < 0)
+        {
+            if (stream.close_after_write_)
+            {
+                // La fermeture liée a été annulée avec l'écriture : le fd nous revient.
+                ::close(stream.fd_);
+            }
+            std::shared_ptr<void> owner = std::move(stream.write_owner_);
+            stream.on_write(to_error_code(res), stream.written_);
+            return;
+        }
+
+        // Écriture partielle : on avance dans les iovec et on relance le reste.
+        std::size_t remaining = static_cast<std::size_t>(res);
+        stream.written_ += remaining;
+        while (stream.iov_offset_ < stream.iov_.size() && remaining >= stream.iov_[stream.iov_offset_].iov_len)
+        {
+            remaining -= stream.iov_[stream.iov_offset_].iov_len;
+            ++stream.iov_offset_;
+        }
+        if (stream.iov_offset_ < stream.iov_.size())
+        {
+            iovec &iov = stream.iov_[stream.iov_offset_];
+            iov.iov_base = static_cast<char *>(iov.iov_base) + remaining;
+            iov.iov_len -= remaining;
+            submit_write(stream);
+            return;
+        }
+
+        std::shared_ptr<void> owner = std::move(stream.write_owner_);
+        stream.on_write({}, stream.written_);
+    }
+
+    void UringLoop::submit_accept()
+    {
+        io_uring_sqe *sqe = nullptr;
+        while (!(sqe = ring_->get_sqe()))
+        {
+            flush();
+        }
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = listen_fd_;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        sqe->user_data = tag(this, OP_ACCEPT);
+        accept_armed_ = true;
+        schedule_flush();
+    }
+
+    void UringLoop::submit_recv(Stream &stream, bool select_buffer)
+    {
+        io_uring_sqe *sqe = nullptr;
+        while (!(sqe = ring_->get_sqe()))
+        {
+            flush();
+        }
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = stream.fd_;
+        if (select_buffer)
+        {
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = BUFFER_GROUP;
+        }
+        else
+        {
+            sqe->addr = reinterpret_cast<std::uint64_t>(stream.recv_fallback_.data());
+            sqe->len = static_cast<std::uint32_t>(stream.recv_fallback_.size());
+        }
+        sqe->user_data = tag(&stream, OP_RECV);
+        schedule_flush();
+    }
+
+    void UringLoop::submit_write(Stream &stream)
+    {
+        // Deux SQE consécutives pour la paire écriture + fermeture liée.
+        while (ring_->sq_local_tail - __atomic_load_n(ring_->sq_head, __ATOMIC_ACQUIRE) + 2 > ring_->sq_entries)
+        {
+            flush();
+        }
+
+        stream.msg_ = msghdr{};
+        stream.msg_.msg_iov = stream.iov_.data() + stream.iov_offset_;
+        stream.msg_.msg_iovlen = stream.iov_.size() - stream.iov_offset_;
+
+        io_uring_sqe *sqe = ring_->get_sqe();
+        sqe->opcode = IORING_OP_SENDMSG;
+        sqe->fd = stream.fd_;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&stream.msg_);
+        sqe->len = 1;
+        // MSG_WAITALL : le noyau relance lui-même les envois partiels, et un envoi resté
+        // incomplet rompt la chaîne, ce qui annule la fermeture liée.
+        sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        sqe->user_data = tag(&stream, OP_WRITE);
+
+        if (stream.close_after_write_)
+        {
+            // Exécutée seulement si l'écriture est complète ; sinon annulée (-ECANCELED).
+            sqe->flags = IOSQE_IO_LINK;
+            io_uring_sqe *close_sqe = ring_->get_sqe();
+            close_sqe->opcode = IORING_OP_CLOSE;
+            close_sqe->fd = stream.fd_;
+            close_sqe->user_data = OP_CLOSE;
+        }
+        schedule_flush();
+    }
+
+    void UringLoop::schedule_flush()
+    {
+        // Les SQE préparées pendant ce passage de l'io_context partent ensemble.
+        if (flush_scheduled_)
+        {
+            return;
+        }
+        flush_scheduled_ = true;
+        net::post(io_context_, [this]()
+                  { flush(); });
+    }
+
+    void UringLoop::flush()
+    {
+        flush_scheduled_ = false;
+        while (ring_->pending() > 0)
+        {
+            int ret = ring_->submit();
+            submit_calls_.fetch_add(1, std::memory_order_relaxed);
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EBUSY)
+                {
+                    // CQ saturée : on la vide avant de réessayer.
+                    process_completions();
+                    continue;
+                }
+                spdlog::error("io_uring_enter failed: {}", std::strerror(errno));
+                return;
+            }
+            if (ret == 0)
+            {
+                return;
+            }
+            submitted_.fetch_add(static_cast<std::uint64_t>(ret), std::memory_order_relaxed);
+        }
+    }
+
+#else
+
+    struct UringLoop::Ring
+    {
+    };
+
+    bool UringLoop::supported()
+    {
+        return false;
+    }
+
+    UringLoop::UringLoop(net::io_context &io_context)
+        : io_context_(io_context), ring_(), ring_watch_(io_context), listen_fd_(-1), accept_handler_(),
+          accept_armed_(false), accept_paused_(false), flush_scheduled_(false), running_(false),
+          submit_calls_(0), submitted_(0), completions_(0), buffer_exhausted_(0)
+    {
+        throw std::runtime_error("io_uring is not available on this platform");
+    }
+
+    UringLoop::~UringLoop() {}
+    void UringLoop::start() {}
+    void UringLoop::stop() {}
+    void UringLoop::listen(int, AcceptHandler) {}
+    void UringLoop::pause_accept() {}
+    void UringLoop::resume_accept() {}
+    void UringLoop::recv(Stream &, int, net::mutable_buffer, std::shared_ptr<void>) {}
+    void UringLoop::write(Stream &, int, const std::vector<net::const_buffer> &, bool, std::shared_ptr<void>) {}
+    void UringLoop::close(int) {}
+    UringLoop::Stats UringLoop::stats() const { return Stats{0, 0, 0, 0}; }
+
+#endif
+}
@@ -0,0 +1,124 @@
+#ifndef URINGLOOP_HPP
+#define URINGLOOP_HPP
+
+#include <boost/asio.hpp>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Softadastra
+{
+    namespace net = boost::asio;
+
+    constexpr unsigned URING_QUEUE_DEPTH = 2048;
+    constexpr unsigned URING_BUFFER_COUNT = 512; // puissance de 2
+    constexpr std::size_t URING_BUFFER_SIZE = 8 * 1024;
+
+    // Transport io_uring d'un shard : accept multishot, lectures dans un anneau de tampons
+    // fournis au noyau, écritures vectorisées éventuellement chaînées à la fermeture.
+    // L'anneau n'est manipulé que par le thread du shard (io_model "sharded") ; son fd est
+    // surveillé par l'io_context, si bien que timers et net::post continuent de fonctionner.
+    // Les soumissions sont regroupées et envoyées en un seul io_uring_enter par passage.
+    class UringLoop
+    {
+    public:
+        // Connexion servie par l'anneau, chaînée dans l'objet qui la possède (comme
+        // TimingWheel::Timer) : au plus une lecture et une écriture en cours à la fois.
+        class Stream
+        {
+        public:
+            Stream() = default;
+            virtual ~Stream() = default;
+            Stream(const Stream &) = delete;
+            Stream &operator=(const Stream &) = delete;
+
+        protected:
+            // data pointe sur un tampon de l'anneau, rendu au noyau au retour ; nullptr si
+            // l'anneau était vide et que la lecture s'est faite dans le tampon de repli.
+            virtual void on_recv(const boost::system::error_code &ec, const char *data, std::size_t size) = 0;
+            virtual void on_write(const boost::system::error_code &ec, std::size_t size) = 0;
+
+        private:
+            friend class UringLoop;
+            int fd_ = -1;
+            std::shared_ptr<void> recv_owner_; // garde l'objet en vie jusqu'à la complétion
+            std::shared_ptr<void> write_owner_;
+            net::mutable_buffer recv_fallback_;
+            std::vector<iovec> iov_;
+            std::size_t iov_offset_ = 0;
+            std::size_t written_ = 0;
+            msghdr msg_{};
+            bool close_after_write_ = false;
+        };
+
+        struct Stats
+        {
+            std::uint64_t submit_calls;     // appels io_uring_enter
+            std::uint64_t submitted;        // SQE soumises
+            std::uint64_t completions;      // CQE traitées
+            std::uint64_t buffer_exhausted; // lectures repliées faute de tampon libre
+        };
+
+        using AcceptHandler = std::function<void(int fd)>;
+
+        // Vrai si le noyau offre tout ce qu'utilise ce transport (5.19+ : accept multishot,
+        // anneaux de tampons fournis) et que io_uring n'est pas bloqué (seccomp, sysctl).
+        static bool supported();
+
+        explicit UringLoop(net::io_context &io_context);
+        ~UringLoop();
+        UringLoop(const UringLoop &) = delete;
+        UringLoop &operator=(const UringLoop &) = delete;
+
+        void start();
+        void stop();
+
+        void listen(int listen_fd, AcceptHandler handler);
+        void pause_accept();
+        void resume_accept();
+
+        void recv(Stream &stream, int fd, net::mutable_buffer fallback, std::shared_ptr<void> owner);
+        // Avec close_after, le fd est fermé par le noyau après le dernier octet (SQE liées) :
+        // il ne doit plus être utilisé par l'appelant.
+        void write(Stream &stream, int fd, const std::vector<net::const_buffer> &buffers, bool close_after,
+                   std::shared_ptr<void> owner);
+        void close(int fd);
+
+        Stats stats() const;
+
+    private:
+        struct Ring;
+
+        void wait_completions();
+        void process_completions();
+        void complete_accept(std::int32_t res, std::uint32_t flags);
+        void complete_recv(Stream &stream, std::int32_t res, std::uint32_t flags);
+        void complete_write(Stream &stream, std::int32_t res);
+        void submit_accept();
+        void submit_recv(Stream &stream, bool select_buffer);
+        void submit_write(Stream &stream);
+        void schedule_flush();
+        void flush();
+
+        net::io_context &io_context_;
+        std::unique_ptr<Ring> ring_;
+        net::posix::stream_descriptor ring_watch_;
+        int listen_fd_;
+        AcceptHandler accept_handler_;
+        bool accept_armed_;
+        bool accept_paused_;
+        bool flush_scheduled_;
+        bool running_;
+        // Lus par /server-status depuis un autre thread.
+        std::atomic<std::uint64_t> submit_calls_;
+        std::atomic<std::uint64_t> submitted_;
+        std::atomic<std::uint64_t> completions_;
+        std::atomic<std::uint64_t> buffer_exhausted_;
+    };
+}
+
+#endif // URINGLOOP_HPP
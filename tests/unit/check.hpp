@@ -0,0 +1,24 @@
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <cstdio>
+
+// Vérification des tests unitaires : un échec est affiché puis compté, et main() rend
+// check_failures() pour que ctest le voie.
+inline int &check_failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                   \
+    do                                                                                     \
+    {                                                                                      \
+        if (!(condition))                                                                  \
+        {                                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++check_failures();                                                            \
+        }                                                                                  \
+    } while (0)
+
+#endif // CHECK_HPP
@@ -0,0 +1,172 @@
+// AsyncLog : anneau plein, les lignes en trop sont perdues et comptées sans bloquer
+// l'appelant ; une ligne plus longue que LINE_SIZE est coupée et comptée.
+//
+// Le thread d'écriture est retenu dans le sink : la première ligne occupe son créneau
+// tant qu'il n'est pas relâché, le remplissage de l'anneau ne dépend donc pas du temps.
+
+#include "logging/AsyncLog.hpp"
+#include "check.hpp"
+#include <spdlog/sinks/base_sink.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+using namespace Softadastra;
+
+namespace
+{
+    class HeldSink : public spdlog::sinks::base_sink<std::mutex>
+    {
+    public:
+        void hold() { set(true); }
+        void release() { set(false); }
+
+        // Attend que le thread d'écriture soit entré dans le sink.
+        void wait_entered()
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            changed_.wait(lock, [this]
+                          { return entered_; });
+        }
+
+        std::size_t lines() const
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            return lines_;
+        }
+
+        std::size_t longest() const
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            return longest_;
+        }
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg &msg) override
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            entered_ = true;
+            changed_.notify_all();
+            changed_.wait(lock, [this]
+                          { return !held_; });
+            ++lines_;
+            longest_ = std::max(longest_, msg.payload.size());
+        }
+
+        void flush_() override {}
+
+    private:
+        void set(bool held)
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            held_ = held;
+            entered_ = false;
+            changed_.notify_all();
+        }
+
+        mutable std::mutex state_mutex_;
+        std::condition_variable changed_;
+        bool held_ = false;
+        bool entered_ = false;
+        std::size_t lines_ = 0;
+        std::size_t longest_ = 0;
+    };
+
+    constexpr std::size_t QUEUE_SIZE = 8;
+
+    void ring_full_drops(HeldSink &sink)
+    {
+        AsyncLog &log = AsyncLog::instance();
+        const AsyncLog::Stats before = log.stats();
+        const std::size_t lines_before = sink.lines();
+
+        sink.hold();
+        log.start(AsyncLog::Options{spdlog::level::info, QUEUE_SIZE, 1.0});
+        log.log(spdlog::level::info, "line {}", 0);
+        sink.wait_entered();
+
+        // Le créneau de la ligne 0 reste pris : QUEUE_SIZE - 1 places, le reste est perdu.
+        constexpr std::size_t TOTAL = 100;
+        for (std::size_t i = 1; i < TOTAL; ++i)
+        {
+            log.log(spdlog::level::info, "line {}", i);
+        }
+        CHECK(log.stats().dropped - before.dropped == TOTAL - QUEUE_SIZE);
+
+        sink.release();
+        log.stop();
+        const AsyncLog::Stats after = log.stats();
+        CHECK(after.written - before.written == QUEUE_SIZE);
+        CHECK(after.dropped - before.dropped == TOTAL - QUEUE_SIZE);
+        CHECK(sink.lines() - lines_before == QUEUE_SIZE);
+    }
+
+    void ring_reusable_after_drops(HeldSink &sink)
+    {
+        // Après un arrêt, l'anneau vidé accepte de nouveau QUEUE_SIZE lignes.
+        AsyncLog &log = AsyncLog::instance();
+        const AsyncLog::Stats before = log.stats();
+
+        sink.hold();
+        log.start(AsyncLog::Options{spdlog::level::info, QUEUE_SIZE, 1.0});
+        log.log(spdlog::level::info, "line {}", 0);
+        sink.wait_entered();
+        for (std::size_t i = 1; i < QUEUE_SIZE; ++i)
+        {
+            log.log(spdlog::level::info, "line {}", i);
+        }
+        CHECK(log.stats().dropped == before.dropped);
+
+        sink.release();
+        log.stop();
+        CHECK(log.stats().written - before.written == QUEUE_SIZE);
+    }
+
+    void long_line_truncated(HeldSink &sink)
+    {
+        AsyncLog &log = AsyncLog::instance();
+        const AsyncLog::Stats before = log.stats();
+
+        log.start(AsyncLog::Options{spdlog::level::info, QUEUE_SIZE, 1.0});
+        log.log(spdlog::level::info, "{}", std::string(AsyncLog::LINE_SIZE + 50, 'x'));
+        log.log(spdlog::level::info, "{}", std::string(AsyncLog::LINE_SIZE, 'y'));
+        log.stop();
+
+        const AsyncLog::Stats after = log.stats();
+        CHECK(after.written - before.written == 2);
+        CHECK(after.truncated - before.truncated == 1);
+        CHECK(sink.longest() == AsyncLog::LINE_SIZE);
+    }
+
+    void below_level_ignored(HeldSink &sink)
+    {
+        // SOFTADASTRA_LOG filtre avant l'anneau : rien d'écrit, rien de perdu.
+        AsyncLog &log = AsyncLog::instance();
+        const AsyncLog::Stats before = log.stats();
+        const std::size_t lines_before = sink.lines();
+
+        log.start(AsyncLog::Options{spdlog::level::warn, QUEUE_SIZE, 1.0});
+        for (int i = 0; i < 50; ++i)
+        {
+            SOFTADASTRA_LOG(spdlog::level::info, "line {}", i);
+        }
+        log.stop();
+
+        const AsyncLog::Stats after = log.stats();
+        CHECK(after.written == before.written && after.dropped == before.dropped);
+        CHECK(sink.lines() == lines_before);
+    }
+}
+
+int main()
+{
+    auto sink = std::make_shared<HeldSink>();
+    spdlog::set_default_logger(std::make_shared<spdlog::logger>("test", sink));
+
+    ring_full_drops(*sink);
+    ring_reusable_after_drops(*sink);
+    long_line_truncated(*sink);
+    below_level_ignored(*sink);
+    return check_failures() == 0 ? 0 : 1;
+}
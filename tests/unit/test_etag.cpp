@@ -0,0 +1,79 @@
+// ETag : comparaison faible de If-None-Match (W/, liste, "*") et suffixe d'encodage
+// ajouté par la compression, ignoré des deux côtés.
+
+#include "http/ETag.hpp"
+#include "check.hpp"
+#include <string>
+
+using namespace Softadastra;
+
+namespace
+{
+    void weak_matching()
+    {
+        const std::string etag = etag_for("{\"id\":1}");
+        CHECK(etag.size() == 18 && etag.front() == '"' && etag.back() == '"');
+        CHECK(etag == etag_for("{\"id\":1}"));
+        CHECK(etag != etag_for("{\"id\":2}"));
+
+        CHECK(etag_matches(etag, etag));
+        CHECK(etag_matches("W/" + etag, etag));
+        CHECK(etag_matches(etag, "W/" + etag));
+        CHECK(etag_matches("\"other\", " + etag, etag));
+        CHECK(etag_matches(" \"other\" ,\t" + etag + " ", etag));
+        CHECK(etag_matches("*", etag));
+
+        CHECK(!etag_matches("\"other\"", etag));
+        CHECK(!etag_matches("", etag));
+        CHECK(!etag_matches("*", ""));
+    }
+
+    void encoding_suffix()
+    {
+        http::response<http::string_body> res;
+        res.set(http::field::etag, "\"abc\"");
+        tag_encoding(res, "gzip");
+        CHECK(res[http::field::etag] == "\"abc-gzip\"");
+
+        // Le client renvoie l'ETag de la variante qu'il a reçue.
+        CHECK(etag_matches("\"abc-gzip\"", "\"abc\""));
+        CHECK(etag_matches("W/\"abc-gzip\"", "\"abc-br\""));
+        CHECK(etag_matches("\"abc\"", "\"abc-zstd\""));
+        CHECK(etag_matches("\"abc-deflate\"", "W/\"abc-deflate\""));
+
+        // Seuls les suffixes connus, et jamais tout le tag.
+        CHECK(!etag_matches("\"abc-lz4\"", "\"abc\""));
+        CHECK(!etag_matches("\"abd-gzip\"", "\"abc\""));
+        CHECK(!etag_matches("\"-gzip\"", "\"\""));
+
+        // Tag sans guillemets : laissé tel quel.
+        http::response<http::string_body> unquoted;
+        unquoted.set(http::field::etag, "abc");
+        tag_encoding(unquoted, "br");
+        CHECK(unquoted[http::field::etag] == "abc");
+    }
+
+    void not_modified()
+    {
+        http::response<http::string_body> res{http::status::ok, 11};
+        res.set(http::field::content_type, "application/json");
+        res.set(http::field::content_encoding, "gzip");
+        res.set(http::field::etag, "\"abc-gzip\"");
+        res.body() = "{}";
+        res.prepare_payload();
+        make_not_modified(res);
+        CHECK(res.result() == http::status::not_modified);
+        CHECK(res.body().empty());
+        CHECK(res.find(http::field::content_length) == res.end());
+        CHECK(res.find(http::field::content_encoding) == res.end());
+        CHECK(res[http::field::etag] == "\"abc-gzip\"");
+    }
+}
+
+int main()
+{
+    weak_matching();
+    encoding_suffix();
+    not_modified();
+    return check_failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+// QueryString : découpage de la cible, décodage %XX et '+', noms encodés, séquences
+// invalides et tampon trop court.
+
+#include "http/QueryString.hpp"
+#include "check.hpp"
+
+using namespace Softadastra;
+
+namespace
+{
+    bool decodes(const char *raw, const char *expected)
+    {
+        char buffer[64];
+        boost::beast::string_view decoded;
+        return QueryString::decode(raw, buffer, sizeof(buffer), decoded) && decoded == expected;
+    }
+
+    bool rejected(const char *raw)
+    {
+        char buffer[64];
+        boost::beast::string_view decoded;
+        return !QueryString::decode(raw, buffer, sizeof(buffer), decoded);
+    }
+
+    void split()
+    {
+        Target target = split_target("/search?q=a%20b&page=2#top");
+        CHECK(target.path == "/search" && target.query == "q=a%20b&page=2");
+        target = split_target("/search#frag?not-a-query");
+        CHECK(target.path == "/search" && target.query.empty());
+        target = split_target("/plain");
+        CHECK(target.path == "/plain" && target.query.empty());
+    }
+
+    void percent_decoding()
+    {
+        CHECK(decodes("a%20b", "a b"));
+        CHECK(decodes("a+b", "a b"));
+        CHECK(decodes("%2B%2b", "++"));
+        CHECK(decodes("caf%C3%A9", "caf\xC3\xA9"));
+        CHECK(decodes("100%25", "100%"));
+        CHECK(decodes("", ""));
+
+        CHECK(rejected("%"));
+        CHECK(rejected("%4"));
+        CHECK(rejected("%zz"));
+        CHECK(rejected("ab%g1"));
+
+        // Capacité exacte acceptée, un octet de moins refusé.
+        char buffer[3];
+        boost::beast::string_view decoded;
+        CHECK(QueryString::decode("a%20b", buffer, 3, decoded) && decoded == "a b");
+        CHECK(!QueryString::decode("a%20b", buffer, 2, decoded));
+    }
+
+    void lookup()
+    {
+        const QueryString query("q=hello+world&&tag=c%2B%2B&empty&na%6De=x&q=second");
+        char buffer[32];
+        boost::beast::string_view value;
+
+        CHECK(query.get("q", buffer, value) && value == "hello world"); // premier q
+        CHECK(query.get("tag", buffer, value) && value == "c++");
+        CHECK(query.contains("empty") && query.get("empty", buffer, value) && value.empty());
+        CHECK(query.get("name", buffer, value) && value == "x"); // nom encodé
+        CHECK(!query.contains("missing"));
+
+        boost::beast::string_view raw;
+        CHECK(query.find("tag", raw) && raw == "c%2B%2B");
+
+        std::size_t pairs = 0;
+        for (const QueryString::Param &param : query)
+        {
+            CHECK(!param.name.empty());
+            ++pairs;
+        }
+        CHECK(pairs == 5); // paire vide sautée
+
+        const QueryString bad("v=%E");
+        CHECK(bad.contains("v") && !bad.get("v", buffer, value));
+    }
+}
+
+int main()
+{
+    split();
+    percent_decoding();
+    lookup();
+    return check_failures() == 0 ? 0 : 1;
+}
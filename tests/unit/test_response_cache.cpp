@@ -0,0 +1,202 @@
+// ResponseCache : un seul calcul par clé (les autres requêtes attendent et sont
+// réveillées par fill ou abandon), entrée périmée servie pendant son recalcul, éviction
+// de la moins récemment utilisée.
+
+#include "http/ResponseCache.hpp"
+#include "check.hpp"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Softadastra;
+using Outcome = ResponseCache::Outcome;
+
+namespace
+{
+    http::response<http::string_body> ok(const std::string &body)
+    {
+        http::response<http::string_body> res{http::status::ok, 11};
+        res.body() = body;
+        res.prepare_payload();
+        return res;
+    }
+
+    ResponseCache::Options options(std::size_t max_entries = 1000)
+    {
+        ResponseCache::Options result;
+        result.enabled = true;
+        result.max_entries = max_entries;
+        return result;
+    }
+
+    void waiters_woken_by_fill()
+    {
+        ResponseCache cache(options());
+        ResponseCache::Policy policy;
+
+        CHECK(cache.lookup("k").outcome == Outcome::Fill);
+        CHECK(cache.lookup("k").outcome == Outcome::Pending);
+
+        std::vector<std::string> received;
+        auto waiter = [&](std::shared_ptr<const PrebuiltResponse> response)
+        { received.push_back(response ? response->response().body() : "null"); };
+        CHECK(cache.wait("k", waiter));
+        CHECK(cache.wait("k", waiter));
+        CHECK(received.empty());
+
+        cache.fill("k", policy, ok("first"));
+        CHECK(received == std::vector<std::string>({"first", "first"}));
+        CHECK(!cache.wait("k", waiter)); // calcul terminé : refaire lookup()
+
+        const ResponseCache::Lookup hit = cache.lookup("k");
+        CHECK(hit.outcome == Outcome::Hit && hit.response->response().body() == "first");
+        CHECK(cache.stats().waits == 2);
+    }
+
+    void uncacheable_result_shared_once()
+    {
+        ResponseCache cache(options());
+        ResponseCache::Policy policy;
+
+        CHECK(cache.lookup("k").outcome == Outcome::Fill);
+        int status = 0;
+        CHECK(cache.wait("k", [&](std::shared_ptr<const PrebuiltResponse> response)
+                         { status = response ? response->response().result_int() : -1; }));
+
+        http::response<http::string_body> error{http::status::internal_server_error, 11};
+        cache.fill("k", policy, error);
+        CHECK(status == 500);                               // transmis aux requêtes en attente
+        CHECK(cache.lookup("k").outcome == Outcome::Fill); // mais pas gardé
+        CHECK(cache.stats().uncacheable == 1);
+    }
+
+    void private_result_not_shared()
+    {
+        // Set-Cookie, private, no-store : chaque requête en attente recalcule la sienne.
+        ResponseCache cache(options());
+        ResponseCache::Policy policy;
+
+        http::response<http::string_body> cookie = ok("alice");
+        cookie.set(http::field::set_cookie, "session=alice");
+        http::response<http::string_body> private_body = ok("alice");
+        private_body.set(http::field::cache_control, "private, max-age=60");
+        http::response<http::string_body> no_store = ok("alice");
+        no_store.set(http::field::cache_control, "no-store");
+
+        for (const auto &res : {cookie, private_body, no_store})
+        {
+            CHECK(cache.lookup("k").outcome == Outcome::Fill);
+            bool woken = false;
+            bool null_response = false;
+            CHECK(cache.wait("k", [&](std::shared_ptr<const PrebuiltResponse> response)
+                             {
+                                 woken = true;
+                                 null_response = response == nullptr;
+                             }));
+
+            const auto own = cache.fill("k", policy, res);
+            CHECK(woken && null_response);
+            CHECK(own && own->response().body() == "alice"); // servie à la requête qui l'a calculée
+            CHECK(cache.stats().entries == 0);
+        }
+        CHECK(cache.stats().uncacheable == 3);
+    }
+
+    void waiters_woken_by_abandon()
+    {
+        ResponseCache cache(options());
+
+        CHECK(cache.lookup("k").outcome == Outcome::Fill);
+        bool woken = false;
+        bool null_response = false;
+        CHECK(cache.wait("k", [&](std::shared_ptr<const PrebuiltResponse> response)
+                         {
+                             woken = true;
+                             null_response = response == nullptr;
+                         }));
+
+        cache.abandon("k");
+        CHECK(woken && null_response);
+        CHECK(cache.stats().entries == 0);
+        CHECK(cache.lookup("k").outcome == Outcome::Fill); // le suivant recalcule
+    }
+
+    void stale_refresh()
+    {
+        ResponseCache cache(options());
+        ResponseCache::Policy policy;
+        policy.ttl = std::chrono::milliseconds(20);
+        policy.stale = std::chrono::seconds(60);
+
+        CHECK(cache.lookup("k").outcome == Outcome::Fill);
+        cache.fill("k", policy, ok("v1"));
+        CHECK(cache.lookup("k").outcome == Outcome::Hit);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+        // Une seule requête lance le recalcul ; toutes reçoivent l'ancienne réponse.
+        const ResponseCache::Lookup stale = cache.lookup("k");
+        CHECK(stale.outcome == Outcome::Stale && stale.response->response().body() == "v1");
+        const ResponseCache::Lookup during = cache.lookup("k");
+        CHECK(during.outcome == Outcome::Hit && during.response->response().body() == "v1");
+
+        cache.fill("k", policy, ok("v2"));
+        const ResponseCache::Lookup fresh = cache.lookup("k");
+        CHECK(fresh.outcome == Outcome::Hit && fresh.response->response().body() == "v2");
+
+        // Recalcul abandonné : l'entrée périmée reste servie, un autre peut relancer.
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        CHECK(cache.lookup("k").outcome == Outcome::Stale);
+        cache.abandon("k");
+        CHECK(cache.lookup("k").outcome == Outcome::Stale);
+        CHECK(cache.stats().stale_hits == 4);
+    }
+
+    void lru_eviction()
+    {
+        // 16 shards d'une entrée chacun : la clé utilisée reste, les autres tournent.
+        ResponseCache cache(options(16 * 2));
+        ResponseCache::Policy policy;
+        policy.ttl = std::chrono::seconds(60);
+
+        CHECK(cache.lookup("hot").outcome == Outcome::Fill);
+        cache.fill("hot", policy, ok("hot"));
+        for (int i = 0; i < 500; ++i)
+        {
+            const std::string key = "key" + std::to_string(i);
+            if (cache.lookup(key).outcome == Outcome::Fill)
+            {
+                cache.fill(key, policy, ok(key));
+            }
+            CHECK(cache.lookup("hot").outcome == Outcome::Hit);
+        }
+        const ResponseCache::Stats stats = cache.stats();
+        CHECK(stats.entries <= 32);
+        CHECK(stats.evictions >= 500 - 32);
+
+        // Une entrée en cours de calcul n'est pas évincée : ses requêtes l'attendent.
+        ResponseCache small(options(16));
+        CHECK(small.lookup("pending").outcome == Outcome::Fill);
+        for (int i = 0; i < 100; ++i)
+        {
+            const std::string key = "other" + std::to_string(i);
+            if (small.lookup(key).outcome == Outcome::Fill)
+            {
+                small.fill(key, policy, ok(key));
+            }
+        }
+        CHECK(small.wait("pending", [](std::shared_ptr<const PrebuiltResponse>) {}));
+    }
+}
+
+int main()
+{
+    waiters_woken_by_fill();
+    uncacheable_result_shared_once();
+    private_result_not_shared();
+    waiters_woken_by_abandon();
+    stale_refresh();
+    lru_eviction();
+    return check_failures() == 0 ? 0 : 1;
+}
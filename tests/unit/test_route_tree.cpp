@@ -0,0 +1,95 @@
+// RouteTree : retour arrière entre texte statique, paramètres typés et joker, et
+// méthodes acceptées (405, Allow) calculées pendant la même descente.
+
+#include "RouteTree.hpp"
+#include "check.hpp"
+
+using namespace Softadastra;
+
+namespace
+{
+    bool find(const RouteTree &tree, const char *path, http::verb method, RouteTree::Match &match)
+    {
+        return tree.find(path, method, match);
+    }
+
+    void backtracking()
+    {
+        RouteTree tree;
+        tree.insert(RoutePattern("/users/me/settings"), http::verb::get, 0);
+        tree.insert(RoutePattern("/users/{id:int}/posts"), http::verb::get, 1);
+        tree.insert(RoutePattern("/users/{name}/posts"), http::verb::get, 2);
+        tree.insert(RoutePattern("/static/{*path}"), http::verb::get, 3);
+        tree.insert(RoutePattern("/items/{id:int}"), http::verb::get, 4);
+        tree.insert(RoutePattern("/items/{slug:slug}"), http::verb::get, 5);
+
+        RouteTree::Match match;
+        CHECK(find(tree, "/users/me/settings", http::verb::get, match) && match.route == 0 && match.count == 0);
+
+        // "me" entre dans la branche statique, qui n'a pas "/posts" : retour au paramètre
+        // int (refusé), puis au paramètre libre.
+        CHECK(find(tree, "/users/me/posts", http::verb::get, match) && match.route == 2);
+        CHECK(match.count == 1 && match.values[0] == "me");
+
+        CHECK(find(tree, "/users/42/posts", http::verb::get, match) && match.route == 1);
+        CHECK(match.count == 1 && match.values[0] == "42");
+
+        // Paramètre le plus strict d'abord.
+        CHECK(find(tree, "/items/42", http::verb::get, match) && match.route == 4);
+        CHECK(find(tree, "/items/blue-shirt", http::verb::get, match) && match.route == 5);
+        CHECK(!find(tree, "/items/a.b", http::verb::get, match));
+
+        CHECK(find(tree, "/static/css/site.css", http::verb::get, match) && match.route == 3);
+        CHECK(match.count == 1 && match.values[0] == "css/site.css");
+
+        CHECK(!find(tree, "/users", http::verb::get, match) && match.allowed == 0);
+        CHECK(!find(tree, "/users/me", http::verb::get, match));
+    }
+
+    void method_not_allowed()
+    {
+        RouteTree tree;
+        tree.insert(RoutePattern("/users/{id:int}"), http::verb::get, 0);
+        tree.insert(RoutePattern("/users/{id:int}"), http::verb::put, 1);
+        tree.insert(RoutePattern("/a/b"), http::verb::get, 2);
+        tree.insert(RoutePattern("/a/{x}"), http::verb::post, 3);
+
+        RouteTree::Match match;
+        CHECK(find(tree, "/users/7", http::verb::put, match) && match.route == 1);
+
+        // Chemin connu, méthode absente : pas de route, mais les méthodes du chemin.
+        CHECK(!find(tree, "/users/7", http::verb::delete_, match));
+        CHECK(match.route == RouteTree::NONE);
+        CHECK(match.allowed == (RouteTree::method_bit(http::verb::get) | RouteTree::method_bit(http::verb::put)));
+        CHECK(RouteTree::allow_header(match.allowed) == "GET, PUT");
+        CHECK(match.fallback == 0);
+
+        // Paramètre refusé par son type : 404, pas 405.
+        CHECK(!find(tree, "/users/abc", http::verb::delete_, match) && match.allowed == 0);
+        CHECK(match.fallback == RouteTree::NONE);
+
+        // Les motifs qui couvrent le chemin après retour arrière comptent aussi.
+        CHECK(!find(tree, "/a/b", http::verb::delete_, match));
+        CHECK(RouteTree::allow_header(match.allowed) == "GET, POST");
+        CHECK(find(tree, "/a/b", http::verb::post, match) && match.route == 3 && match.values[0] == "b");
+    }
+
+    void reregistration()
+    {
+        // Même (motif, méthode) : l'indice est remplacé.
+        RouteTree tree;
+        tree.insert(RoutePattern("/health"), http::verb::get, 0);
+        tree.insert(RoutePattern("/health"), http::verb::get, 7);
+
+        RouteTree::Match match;
+        CHECK(find(tree, "/health", http::verb::get, match) && match.route == 7);
+    }
+}
+
+int main()
+{
+    backtracking();
+    method_not_allowed();
+    reregistration();
+    return check_failures() == 0 ? 0 : 1;
+}
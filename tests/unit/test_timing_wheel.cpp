@@ -0,0 +1,101 @@
+// TimingWheel : une échéance plus longue qu'un tour de roue attend ses tours, jamais en
+// avance ; annulation et réarmement ; on_expire() appelé verrou relâché.
+
+#include "TimingWheel.hpp"
+#include "check.hpp"
+#include <chrono>
+#include <vector>
+
+using namespace Softadastra;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    struct Deadline : TimingWheel::Timer
+    {
+        std::vector<Clock::time_point> fired;
+        std::vector<std::uint64_t> generations; // passées par le tick
+        TimingWheel *rearm_on = nullptr; // réarme depuis on_expire()
+
+        void on_expire(std::uint64_t generation) override
+        {
+            fired.push_back(Clock::now());
+            generations.push_back(generation);
+            if (rearm_on)
+            {
+                TimingWheel *wheel = rearm_on;
+                rearm_on = nullptr;
+                wheel->arm(*this, std::chrono::milliseconds(3));
+            }
+        }
+    };
+
+    constexpr std::chrono::milliseconds TICK{2};
+    constexpr std::size_t SLOTS = 8; // un tour : 16 ms
+
+    void wrap_around()
+    {
+        net::io_context io;
+        TimingWheel wheel(io, TICK, SLOTS);
+        wheel.start();
+
+        // 5 tours et demi : la case est croisée plusieurs fois avant l'expiration.
+        Deadline deadline;
+        const auto armed = Clock::now();
+        wheel.arm(deadline, std::chrono::milliseconds(90));
+        io.run_for(std::chrono::milliseconds(40));
+        CHECK(deadline.fired.empty() && deadline.armed());
+
+        io.run_for(std::chrono::milliseconds(200));
+        CHECK(deadline.fired.size() == 1 && !deadline.armed());
+        if (!deadline.fired.empty())
+        {
+            CHECK(deadline.fired.front() - armed >= std::chrono::milliseconds(90));
+        }
+        wheel.stop();
+    }
+
+    void cancel_and_rearm()
+    {
+        net::io_context io;
+        TimingWheel wheel(io, TICK, SLOTS);
+        wheel.start();
+
+        Deadline cancelled;
+        wheel.arm(cancelled, std::chrono::milliseconds(10));
+        wheel.cancel(cancelled);
+        CHECK(!cancelled.armed());
+
+        // Réarmée avant l'échéance : seule la dernière compte.
+        Deadline rearmed;
+        wheel.arm(rearmed, std::chrono::milliseconds(10));
+        const std::uint64_t first = rearmed.generation();
+        const auto armed = Clock::now();
+        wheel.arm(rearmed, std::chrono::milliseconds(40));
+        CHECK(rearmed.generation() == first + 1);
+
+        // on_expire() peut réarmer : le verrou n'est plus tenu.
+        Deadline chained;
+        chained.rearm_on = &wheel;
+        wheel.arm(chained, std::chrono::milliseconds(5));
+
+        io.run_for(std::chrono::milliseconds(150));
+        CHECK(cancelled.fired.empty());
+        CHECK(rearmed.fired.size() == 1);
+        if (!rearmed.fired.empty())
+        {
+            CHECK(rearmed.fired.front() - armed >= std::chrono::milliseconds(40));
+            CHECK(rearmed.generations.front() == first + 1);
+        }
+        CHECK(chained.fired.size() == 2 && !chained.armed());
+        CHECK(chained.generations.size() == 2 && chained.generations[1] == chained.generations[0] + 1);
+        wheel.stop();
+    }
+}
+
+int main()
+{
+    wrap_around();
+    cancel_and_rearm();
+    return check_failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// Paramètres typés : {id:int} limité à 18 chiffres (toujours dans un int64_t), {id:uuid}
+// vérifié par l'arbre puis décodé en 16 octets par TypedRequestHandler.
+
+#include "RouteTree.hpp"
+#include "TypedRequestHandler.hpp"
+#include "check.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace Softadastra;
+
+namespace
+{
+    static constexpr RoutePattern by_id{"/products/{id:int}"};
+    static constexpr RoutePattern by_uuid{"/orders/{id:uuid}/{slug:slug}"};
+
+    void integer_limit()
+    {
+        RouteTree tree;
+        tree.insert(RoutePattern("/products/{id:int}"), http::verb::get, 0);
+
+        RouteTree::Match match;
+        CHECK(tree.find("/products/999999999999999999", http::verb::get, match)); // 18 chiffres
+        CHECK(!tree.find("/products/1000000000000000000", http::verb::get, match)); // 19
+        CHECK(!tree.find("/products/-1", http::verb::get, match));
+        CHECK(!tree.find("/products/12a", http::verb::get, match));
+
+        CHECK(ParamValue<ParamType::Integer>::parse("999999999999999999") == 999999999999999999LL);
+        CHECK(ParamValue<ParamType::Integer>::parse("0042") == 42);
+    }
+
+    void uuid_format()
+    {
+        RouteTree tree;
+        tree.insert(RoutePattern("/orders/{id:uuid}"), http::verb::get, 0);
+
+        RouteTree::Match match;
+        CHECK(tree.find("/orders/123e4567-e89b-12d3-a456-426614174000", http::verb::get, match));
+        CHECK(tree.find("/orders/123E4567-E89B-12D3-A456-426614174000", http::verb::get, match));
+        CHECK(!tree.find("/orders/123e4567e89b12d3a456426614174000", http::verb::get, match)); // sans tirets
+        CHECK(!tree.find("/orders/123e4567-e89b-12d3-a456-42661417400g", http::verb::get, match));
+        CHECK(!tree.find("/orders/123e4567-e89b-12d3-a456-4266141740001", http::verb::get, match));
+
+        const Uuid uuid = ParamValue<ParamType::Uuid>::parse("123e4567-e89b-12d3-a456-426614174000");
+        const std::array<std::uint8_t, 16> expected{0x12, 0x3e, 0x45, 0x67, 0xe8, 0x9b, 0x12, 0xd3,
+                                                    0xa4, 0x56, 0x42, 0x66, 0x14, 0x17, 0x40, 0x00};
+        CHECK(uuid.bytes == expected);
+        CHECK(ParamValue<ParamType::Uuid>::parse("FFFFFFFF-0000-0000-0000-00000000000A").bytes[15] == 0x0a);
+    }
+
+    void typed_handler()
+    {
+        // Valeurs converties dans l'ordre du motif, depuis les vues de l'arbre.
+        RouteTree tree;
+        tree.insert(by_id, http::verb::get, 0);
+        tree.insert(by_uuid, http::verb::get, 1);
+        const std::vector<std::string> id_names{"id"};
+        const std::vector<std::string> uuid_names{"id", "slug"};
+
+        RouteTree::Match match;
+        http::request<http::string_body> req;
+        http::response<http::string_body> res;
+
+        std::int64_t id = 0;
+        TypedRequestHandler<by_id, std::function<void(const http::request<http::string_body> &, std::int64_t,
+                                                      http::response<http::string_body> &)>>
+            product([&](const http::request<http::string_body> &, std::int64_t value, http::response<http::string_body> &)
+                    { id = value; });
+        CHECK(tree.find("/products/123456789012345678", http::verb::get, match));
+        product(req, RouteParams(id_names, match, QueryString()), res);
+        CHECK(id == 123456789012345678LL);
+
+        Uuid order;
+        std::string slug;
+        TypedRequestHandler<by_uuid, std::function<void(const http::request<http::string_body> &, Uuid, boost::beast::string_view,
+                                                       http::response<http::string_body> &)>>
+            lookup([&](const http::request<http::string_body> &, Uuid value, boost::beast::string_view name,
+                       http::response<http::string_body> &)
+                   {
+                       order = value;
+                       slug = std::string(name);
+                   });
+        CHECK(tree.find("/orders/00000000-0000-0000-0000-0000000000ff/gift-box", http::verb::get, match));
+        lookup(req, RouteParams(uuid_names, match, QueryString()), res);
+        CHECK(order.bytes[15] == 0xff && order.bytes[0] == 0);
+        CHECK(slug == "gift-box");
+    }
+}
+
+int main()
+{
+    integer_limit();
+    uuid_format();
+    typed_handler();
+    return check_failures() == 0 ? 0 : 1;
+}